@@ -0,0 +1,333 @@
+// Benchmark suite: micro-benchmarks for board, rules, shuffle, rendering and snapshots plus full-game
+// macros (classic and large tables), and base-rules games on every board geometry (5x5, 7x7, 9x9).
+// Usage: memoarrr_bench [--filter=substring] [--format=json|csv] [--min-time=seconds]
+#include "BasicEngine.h"
+#include "CardDeck.h"
+#include "Engine.h"
+#include "Game.h"
+#include "MemoryAgent.h"
+#include "RandomAgent.h"
+#include "RubisDeck.h"
+#include "Rules.h"
+#include "Seating.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Description: Keeps the compiler from discarding a computed value.
+// Parameters: value (const T&) result to keep alive.
+template <typename T>
+void keep(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+// Stream buffer that drops all output, so rendering cost is measured without terminal I/O.
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override {
+        return c;
+    }
+    std::streamsize xsputn(const char*, std::streamsize count) override {
+        return count;
+    }
+};
+
+// One registered benchmark: body runs `iterations` operations per call.
+struct Benchmark {
+    std::string name;
+    std::function<void(std::uint64_t iterations)> body;
+};
+
+// Timing summary for one benchmark.
+struct Result {
+    std::string name;
+    std::uint64_t iterations;
+    double seconds;
+};
+
+// Description: Times a benchmark, doubling iterations until minTime is reached.
+// Parameters: bench (const Benchmark&), minTime (double seconds).
+// Returns: Result for the final (long enough) run.
+Result run_benchmark(const Benchmark& bench, double minTime) {
+    std::uint64_t iterations = 1;
+    while (true) {
+        const auto start = std::chrono::steady_clock::now();
+        bench.body(iterations);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() >= minTime || iterations >= (std::uint64_t{1} << 40)) {
+            return Result{bench.name, iterations, elapsed.count()};
+        }
+        iterations *= elapsed.count() < minTime / 16 ? 8 : 2;
+    }
+}
+
+// Description: Builds a game with a freshly shuffled, seeded deck and seated players (four by default).
+// Parameters: deck (CardDeck&), seed (std::uint64_t), mode (RulesMode), display (DisplayMode), seats (std::size_t).
+// Returns: std::unique_ptr<Game> ready to play.
+std::unique_ptr<Game> make_game(CardDeck& deck, std::uint64_t seed, RulesMode mode,
+                                DisplayMode display = DisplayMode::Base, std::size_t seats = 4) {
+    deck.seed(seed);
+    deck.reset();
+    deck.shuffle();
+    GameOptions options;
+    options.rulesMode = mode;
+    options.displayMode = display;
+    std::unique_ptr<Game> game(new Game(deck, options));
+    for (std::size_t seat = 0; seat < seats; ++seat) {
+        game->addPlayer(Player("P" + std::to_string(seat + 1), seat_side(seat, seats)));
+    }
+    return game;
+}
+
+// Description: Plays `count` complete seven-round games with random agents under a rules policy.
+// Parameters: count (std::uint64_t), seats (std::size_t) table size.
+template <class Policy>
+void play_games(std::uint64_t count, std::size_t seats = 4) {
+    CardDeck deck;
+    RubisDeck rubies;
+    Rules rules;
+    std::vector<RandomAgent> agents;
+    for (std::uint64_t i = 0; i < count; ++i) {
+        auto game = make_game(deck, i, Policy::kMode, DisplayMode::Base, seats);
+        rubies.seed(i);
+        rubies.reset();
+        rubies.shuffle();
+        BasicEngine<Policy> engine(*game, rules, rubies);
+        agents.clear();
+        for (std::size_t seat = 0; seat < seats; ++seat) {
+            agents.emplace_back(static_cast<std::uint32_t>(i * seats + seat));
+        }
+        for (std::size_t seat = 0; seat < seats; ++seat) {
+            engine.setAgent(seat, agents[seat]);
+        }
+        engine.playGame();
+        keep(game->players()[0].getNRubies());
+    }
+}
+
+// Description: Plays `count` base-rules games of one geometry with fixed seeds through the shared
+// engine, four random or four memory seats.
+// Parameters: count (std::uint64_t), memory (bool) memory seats instead of random ones.
+template <class Geometry>
+void play_grid_games(std::uint64_t count, bool memory) {
+    GridDeck<Geometry> deck;
+    deck.seed(11);
+    RubisDeck rubisDeck;
+    rubisDeck.seed(12);
+    Rules rules;
+    GameOptions options;
+    int rubies = 0;
+    for (std::uint64_t i = 0; i < count; ++i) {
+        deck.reset();
+        deck.shuffle();
+        BasicGame<Geometry> game(deck, options);
+        BasicEngine<BaseRules, Geometry> engine(game, rules, rubisDeck);
+        std::vector<std::unique_ptr<BasicAgent<Geometry>>> agents;
+        for (std::size_t seat = 0; seat < kClassicSeats; ++seat) {
+            game.addPlayer(Player("P" + std::to_string(seat + 1), kClassicSeatOrder[seat]));
+            const auto seed = static_cast<std::uint32_t>(i * kClassicSeats + seat);
+            if (memory) {
+                auto* agent = new BasicMemoryAgent<Geometry>(seed);
+                agents.emplace_back(agent);
+                engine.addObserver(*agent);
+            } else {
+                agents.emplace_back(new BasicRandomAgent<Geometry>(seed));
+            }
+            engine.setAgent(seat, *agents.back());
+        }
+        engine.playGame();
+        rubies += game.players()[0].getNRubies();
+    }
+    keep(rubies);
+}
+
+// Description: Registers every benchmark in the suite.
+// Returns: std::vector<Benchmark>.
+std::vector<Benchmark> make_suite() {
+    std::vector<Benchmark> suite;
+
+    suite.push_back({"board/turnFaceUp+turnFaceDown", [](std::uint64_t n) {
+        CardDeck deck;
+        auto game = make_game(deck, 1, RulesMode::Base);
+        Board& board = game->board();
+        for (std::uint64_t i = 0; i < n; ++i) {
+            const Letter letter = static_cast<Letter>(i % 2 == 0 ? 1 : 3);
+            const Number number = static_cast<Number>(i % 5);
+            keep(board.turnFaceUp(letter, number));
+            keep(board.turnFaceDown(letter, number));
+        }
+    }});
+
+    suite.push_back({"board/faceUpCards", [](std::uint64_t n) {
+        CardDeck deck;
+        auto game = make_game(deck, 2, RulesMode::Base);
+        Board& board = game->board();
+        for (std::size_t row = 0; row < 5; row += 2) {
+            board.turnFaceUp(static_cast<Letter>(row), Number::One);
+            board.turnFaceUp(static_cast<Letter>(row), Number::Five);
+        }
+        for (std::uint64_t i = 0; i < n; ++i) {
+            auto cards = board.faceUpCards();
+            keep(cards.size());
+        }
+    }});
+
+    suite.push_back({"board/hasFaceDownCards", [](std::uint64_t n) {
+        CardDeck deck;
+        auto game = make_game(deck, 3, RulesMode::Base);
+        Board& board = game->board();
+        for (std::uint64_t i = 0; i < n; ++i) {
+            keep(board.hasFaceDownCards());
+        }
+    }});
+
+    suite.push_back({"rules/isValid", [](std::uint64_t n) {
+        CardDeck deck;
+        auto game = make_game(deck, 4, RulesMode::Base);
+        Rules rules;
+        game->setCurrentCard(game->board().getCard(Letter::A, Number::One));
+        game->setCurrentCard(game->board().getCard(Letter::B, Number::Two));
+        for (std::uint64_t i = 0; i < n; ++i) {
+            keep(rules.isValid(*game));
+        }
+    }});
+
+    suite.push_back({"rules/roundOver", [](std::uint64_t n) {
+        CardDeck deck;
+        auto game = make_game(deck, 5, RulesMode::Base);
+        Rules rules;
+        game->setPlayerActive(1, false);
+        for (std::uint64_t i = 0; i < n; ++i) {
+            keep(rules.roundOver(*game));
+        }
+    }});
+
+    suite.push_back({"deck/shuffle", [](std::uint64_t n) {
+        CardDeck deck;
+        deck.seed(6);
+        for (std::uint64_t i = 0; i < n; ++i) {
+            deck.shuffle();
+            keep(deck.size());
+        }
+    }});
+
+    suite.push_back({"render/board", [](std::uint64_t n) {
+        CardDeck deck;
+        auto game = make_game(deck, 7, RulesMode::Base);
+        game->board().turnFaceUp(Letter::A, Number::One);
+        game->board().turnFaceUp(Letter::D, Number::Four);
+        NullBuffer buffer;
+        std::ostream os(&buffer);
+        for (std::uint64_t i = 0; i < n; ++i) {
+            os << game->board();
+        }
+    }});
+
+    suite.push_back({"render/game-expert", [](std::uint64_t n) {
+        CardDeck deck;
+        auto game = make_game(deck, 8, RulesMode::Expert, DisplayMode::Expert);
+        for (std::size_t col = 0; col < 5; ++col) {
+            game->board().turnFaceUp(Letter::B, static_cast<Number>(col));
+        }
+        NullBuffer buffer;
+        std::ostream os(&buffer);
+        for (std::uint64_t i = 0; i < n; ++i) {
+            os << *game;
+        }
+    }});
+
+    suite.push_back({"snapshot/save+restore", [](std::uint64_t n) {
+        CardDeck deck;
+        auto game = make_game(deck, 9, RulesMode::Expert);
+        RubisDeck rubies;
+        Rules rules;
+        Engine engine(*game, rules, rubies);
+        game->board().turnFaceUp(Letter::C, Number::Two);
+        game->setCurrentCard(game->board().getCard(Letter::C, Number::Two));
+        for (std::uint64_t i = 0; i < n; ++i) {
+            const GameSnapshot snapshot = engine.snapshot();
+            engine.restore(snapshot);
+            keep(snapshot.faceUp);
+        }
+    }});
+
+    suite.push_back({"grid/5x5-game-random", [](std::uint64_t n) { play_grid_games<ClassicGeometry>(n, false); }});
+    suite.push_back({"grid/5x5-game-memory", [](std::uint64_t n) { play_grid_games<ClassicGeometry>(n, true); }});
+    suite.push_back({"grid/7x7-game-random", [](std::uint64_t n) { play_grid_games<Geometry7x7>(n, false); }});
+    suite.push_back({"grid/7x7-game-memory", [](std::uint64_t n) { play_grid_games<Geometry7x7>(n, true); }});
+    suite.push_back({"grid/9x9-game-random", [](std::uint64_t n) { play_grid_games<Geometry9x9>(n, false); }});
+    suite.push_back({"grid/9x9-game-memory", [](std::uint64_t n) { play_grid_games<Geometry9x9>(n, true); }});
+
+    suite.push_back({"game/full-base", [](std::uint64_t n) { play_games<BaseRules>(n); }});
+    suite.push_back({"game/full-expert", [](std::uint64_t n) { play_games<ExpertRules>(n); }});
+    suite.push_back({"game/full-base-16seats", [](std::uint64_t n) { play_games<BaseRules>(n, 16); }});
+    suite.push_back({"game/full-expert-32seats", [](std::uint64_t n) { play_games<ExpertRules>(n, 32); }});
+    return suite;
+}
+
+} // namespace
+
+// Description: Runs the selected benchmarks and prints one JSON document (or CSV) to stdout.
+// Returns: int exit code (0 for success).
+int main(int argc, char** argv) {
+    std::string filter;
+    std::string format = "json";
+    double minTime = 0.25;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.compare(0, 9, "--filter=") == 0) {
+            filter = arg.substr(9);
+        } else if (arg.compare(0, 9, "--format=") == 0) {
+            format = arg.substr(9);
+        } else if (arg.compare(0, 11, "--min-time=") == 0) {
+            minTime = std::atof(arg.c_str() + 11);
+        } else {
+            std::cerr << "Unknown argument: " << arg << '\n';
+            return 1;
+        }
+    }
+
+    std::vector<Result> results;
+    for (const auto& bench : make_suite()) {
+        if (filter.empty() || bench.name.find(filter) != std::string::npos) {
+            results.push_back(run_benchmark(bench, minTime));
+        }
+    }
+
+    if (format == "csv") {
+        std::cout << "name,iterations,seconds,ns_per_op,ops_per_sec\n";
+        for (const auto& result : results) {
+            std::cout << result.name << ',' << result.iterations << ',' << result.seconds << ','
+                      << result.seconds * 1e9 / result.iterations << ',' << result.iterations / result.seconds
+                      << '\n';
+        }
+        return 0;
+    }
+
+    std::cout << "{\n  \"benchmarks\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+        std::cout << "    {\"name\": \"" << result.name << "\", \"iterations\": " << result.iterations
+                  << ", \"seconds\": " << result.seconds
+                  << ", \"ns_per_op\": " << result.seconds * 1e9 / result.iterations
+                  << ", \"ops_per_sec\": " << result.iterations / result.seconds << '}'
+                  << (i + 1 < results.size() ? "," : "") << '\n';
+    }
+    std::cout << "  ]\n}\n";
+    return 0;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Enums.h"
+#include "Game.h"
+
+#include <cstdint>
+#include <vector>
+
+// Decision source for one seat of a game on a Geometry board. The engine asks an agent whenever a
+// choice is required. Agent is the classic 5x5 instance.
+template <class Geometry>
+class BasicAgent {
+public:
+    using Mask = typename Geometry::Mask;
+
+    virtual ~BasicAgent() = default;
+
+    // Parameters: game (const BasicGame<Geometry>&), player (const Player&), cells (the seat's peek cards,
+    // currently face up, as a cell mask; see peek_mask in Seating.h). Called once per round while they are
+    // revealed. Default ignores the peek.
+    virtual void peek(const BasicGame<Geometry>&, const Player&, Mask) {}
+
+    // Parameters: game (const BasicGame<Geometry>&), player (const Player&), blockActive (bool) whether walrus
+    // block applies. Returns a face-down Position to flip (not blocked when blockActive is true).
+    virtual Position chooseFlip(const BasicGame<Geometry>& game, const Player& player, bool blockActive) = 0;
+
+    // Parameters: game, player, origin (octopus position), options (adjacent swap targets, never empty).
+    // Returns one entry of options.
+    virtual Position chooseOctopusTarget(const BasicGame<Geometry>& game, const Player& player,
+                                         const Position& origin, const std::vector<Position>& options) = 0;
+
+    // Parameters: game, player, options (face-up cards eligible, never empty), target (output).
+    // Returns true after writing one entry of options to target, false to skip the ability.
+    virtual bool choosePenguinTarget(const BasicGame<Geometry>& game, const Player& player,
+                                     const std::vector<Position>& options, Position& target) = 0;
+
+    // Parameters: game, player, target (output). Returns true after writing a face-down card to block,
+    // false to skip the ability.
+    virtual bool chooseWalrusBlock(const BasicGame<Geometry>& game, const Player& player, Position& target) = 0;
+};
+
+using Agent = BasicAgent<ClassicGeometry>;
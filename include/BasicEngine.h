@@ -0,0 +1,210 @@
+#pragma once
+
+#include "Engine.h"
+#include "RulesPolicy.h"
+#include "Trace.h"
+
+#include <stdexcept>
+
+// Engine whose turn loop is compiled for one rules policy, ignoring game.rulesMode(): with
+// BaseRules no ability handling is compiled at all, with ExpertRules each animal's effect is
+// inlined into the flip. User-defined policies (RulesPolicy.h) work the same way, on any geometry.
+template <class Policy, class Geometry = ClassicGeometry>
+class BasicEngine : public GameEngine<Geometry> {
+public:
+    // Parameters: game (BasicGame<Geometry>&), rules (const Rules&), rubisDeck (RubisDeck&). Objects must
+    // outlive the engine.
+    BasicEngine(BasicGame<Geometry>& game, const Rules& rules, RubisDeck& rubisDeck)
+        : GameEngine<Geometry>(game, rules, rubisDeck) {
+        this->template usePolicy<Policy>();
+    }
+};
+
+template <class Geometry>
+template <class Policy>
+void GameEngine<Geometry>::usePolicy() {
+    m_advance = &GameEngine::advanceWith<Policy>;
+    m_step = &GameEngine::stepWith<Policy>;
+    m_flip = &GameEngine::flipWith<Policy>;
+}
+
+template <class Geometry>
+template <class Policy>
+const BasicInputRequest<Geometry>& GameEngine<Geometry>::advanceWith() {
+    while (stepWith<Policy>()) {
+    }
+    return m_request;
+}
+
+// Performs one transition of the turn flow. Returns false when the game is over or a seat
+// without an agent has to decide (m_request then describes the decision).
+template <class Geometry>
+template <class Policy>
+bool GameEngine<Geometry>::stepWith() {
+    switch (m_phase) {
+    case Phase::NotStarted:
+        emit(makeEvent(EventType::GameStart));
+        m_phase = m_rules.gameOver(m_game) ? Phase::GameEnd : Phase::RoundStart;
+        return true;
+    case Phase::RoundStart:
+        startRound();
+        return true;
+    case Phase::TurnStart:
+        startTurn();
+        return true;
+    case Phase::Flip: {
+        if (!hasAgent(m_turnIndex)) {
+            return false;
+        }
+        const Player& player = m_game.players().at(m_turnIndex);
+        Position choice{Letter::A, Number::One};
+        {
+            TRACE_SCOPE("input.flip");
+            choice = agentFor(m_turnIndex).chooseFlip(m_game, player, m_request.blockActive);
+        }
+        if (!flipWith<Policy>(choice)) {
+            throw std::logic_error("Agent chose a card that cannot be flipped");
+        }
+        return true;
+    }
+    case Phase::Octopus:
+        return Policy::ability(FaceAnimal::Octopus) && askOctopus();
+    case Phase::Penguin:
+        return Policy::ability(FaceAnimal::Penguin) && askPenguin();
+    case Phase::Walrus:
+        return Policy::ability(FaceAnimal::Walrus) && askWalrus();
+    case Phase::AfterFlip: {
+        const Player& player = m_game.players().at(m_turnIndex);
+        if (Policy::ability(FaceAnimal::Crab) && m_extraFlip && player.isActive() &&
+            m_game.board().hasFaceDownCards()) {
+            m_extraFlip = false;
+            await(Phase::Flip);
+        } else {
+            m_phase = Phase::EndTurn;
+        }
+        return true;
+    }
+    case Phase::EndTurn:
+        // Eliminated seats are stepped over in one bit scan.
+        m_turnIndex = m_game.nextActivePlayer(m_turnIndex);
+        m_phase = Phase::TurnStart;
+        return true;
+    case Phase::RoundEnd:
+        finishRound();
+        return true;
+    case Phase::GameEnd:
+        for (auto& player : m_game.players()) {
+            player.setDisplayMode(true);
+        }
+        m_phase = Phase::Finished;
+        emit(makeEvent(EventType::GameEnd));
+        return true;
+    case Phase::Finished:
+        m_request.kind = InputKind::None;
+        m_request.options.clear();
+        m_request.optionMask = Mask{};
+        return false;
+    }
+    return false;
+}
+
+// Turns the chosen card face up and applies its consequences. Returns false, changing nothing,
+// when the card cannot be flipped.
+template <class Geometry>
+template <class Policy>
+bool GameEngine<Geometry>::flipWith(const Position& choice) {
+    TRACE_SCOPE("flip");
+    BasicBoard<Geometry>& board = m_game.board();
+    // A block never leaves the player without a legal flip.
+    const bool blockActive = m_walrusBlockActive && hasFlippableCard(true);
+    if (board.tryTurnFaceUp(choice, blockActive) != FlipStatus::Flipped) {
+        return false;
+    }
+    const BasicCard<Geometry> current = board.cardAt(BasicBoard<Geometry>::indexOf(choice));
+    m_game.setCurrentCard(current);
+    m_request.kind = InputKind::None;
+
+    if (m_walrusBlockActive) {
+        board.clearBlocked();
+        m_walrusBlockActive = false;
+    }
+
+    GameEvent event = makeEvent(EventType::Flip, m_turnIndex);
+    event.position = choice;
+    emit(event);
+
+    const BasicCard<Geometry>* previous = m_game.getPreviousCard();
+    bool matched = true;
+    if (previous != nullptr) {
+        TRACE_SCOPE("rules.match");
+        matched = Policy::matches(*previous, current);
+    }
+    if (!matched) {
+        m_game.setPlayerActive(m_turnIndex, false);
+        m_phase = Phase::EndTurn;
+        GameEvent mismatch = makeEvent(EventType::Mismatch, m_turnIndex);
+        mismatch.position = choice;
+        emit(mismatch);
+        return true;
+    }
+
+    startAbility<Policy>(choice);
+    return true;
+}
+
+// Applies the revealed animal's ability when the policy enables it, or waits for the choice it needs.
+// Animals past Walrus (larger alphabets) match no case and have no ability.
+template <class Geometry>
+template <class Policy>
+void GameEngine<Geometry>::startAbility(const Position& position) {
+    TRACE_SCOPE("ability.start");
+    m_abilityOrigin = position;
+    m_phase = Phase::AfterFlip;
+    switch (static_cast<FaceAnimal>(*m_game.getCurrentCard())) {
+    case FaceAnimal::Octopus: {
+        if (!Policy::ability(FaceAnimal::Octopus)) {
+            break;
+        }
+        const Mask options = octopusTargets(position);
+        if (!MaskOps<Mask>::any(options)) {
+            emit(abilityEvent(EventType::OctopusNoTarget));
+            break;
+        }
+        await(Phase::Octopus, options);
+        break;
+    }
+    case FaceAnimal::Penguin: {
+        if (!Policy::ability(FaceAnimal::Penguin)) {
+            break;
+        }
+        if (m_game.getPreviousCard() == nullptr) {
+            emit(abilityEvent(EventType::PenguinNoPrevious));
+            break;
+        }
+        const Mask options = penguinTargets(position);
+        if (!MaskOps<Mask>::any(options)) {
+            emit(abilityEvent(EventType::PenguinNoTarget));
+            break;
+        }
+        await(Phase::Penguin, options);
+        break;
+    }
+    case FaceAnimal::Walrus:
+        if (Policy::ability(FaceAnimal::Walrus)) {
+            await(Phase::Walrus);
+        }
+        break;
+    case FaceAnimal::Crab:
+        if (Policy::ability(FaceAnimal::Crab)) {
+            emit(abilityEvent(EventType::CrabExtraFlip));
+            m_extraFlip = true;
+        }
+        break;
+    case FaceAnimal::Turtle:
+        if (Policy::ability(FaceAnimal::Turtle)) {
+            emit(abilityEvent(EventType::TurtleSkip));
+            ++m_skipCount;
+        }
+        break;
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Parameters: mask (std::uint32_t, non-zero). Returns the index of the lowest set bit.
+inline unsigned count_trailing_zeros(std::uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+// Parameters: mask (std::uint32_t). Returns the number of set bits.
+inline unsigned popcount(std::uint32_t mask) {
+#if defined(_MSC_VER)
+    return static_cast<unsigned>(__popcnt(mask));
+#else
+    return static_cast<unsigned>(__builtin_popcount(mask));
+#endif
+}
+
+// Parameters: mask (std::uint64_t, non-zero). Returns the index of the lowest set bit.
+inline unsigned count_trailing_zeros(std::uint64_t mask) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return static_cast<unsigned>(index);
+#elif defined(_MSC_VER)
+    const auto low = static_cast<std::uint32_t>(mask);
+    return low != 0 ? count_trailing_zeros(low) : 32 + count_trailing_zeros(static_cast<std::uint32_t>(mask >> 32));
+#else
+    return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+}
+
+// Parameters: mask (std::uint64_t). Returns the number of set bits.
+inline unsigned popcount(std::uint64_t mask) {
+#if defined(_MSC_VER)
+    return popcount(static_cast<std::uint32_t>(mask)) + popcount(static_cast<std::uint32_t>(mask >> 32));
+#else
+    return static_cast<unsigned>(__builtin_popcountll(mask));
+#endif
+}
+
+// Parameters: mask (std::uint32_t), n (unsigned, < popcount(mask)). Returns the index of the n-th set bit.
+inline unsigned nth_set_bit(std::uint32_t mask, unsigned n) {
+    while (n-- > 0) {
+        mask &= mask - 1;
+    }
+    return count_trailing_zeros(mask);
+}
+
+// Parameters: mask (std::uint32_t), index (unsigned, < 32). Returns the first set bit after index,
+// wrapping around to the lowest set bit (index itself when it is the only one), or index when mask is 0.
+inline unsigned next_set_bit_cyclic(std::uint32_t mask, unsigned index) {
+    const std::uint32_t later = index >= 31 ? 0u : mask & ~((2u << index) - 1u);
+    if (later != 0) {
+        return count_trailing_zeros(later);
+    }
+    return mask != 0 ? count_trailing_zeros(mask) : index;
+}
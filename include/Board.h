@@ -1,20 +1,38 @@
 #pragma once
 
+#include "Bits.h"
 #include "Card.h"
+#include "CellMasks.h"
 #include "DeckFactory.h"
 #include "Enums.h"
 #include "Exceptions.h"
+#include "GridBoard.h"
 
 #include <array>
+#include <cstdint>
 #include <iosfwd>
-#include <memory>
 #include <utility>
 #include <vector>
 
-class Board {
+// Outcome of a non-throwing flip request.
+enum class FlipStatus { Flipped, AlreadyFaceUp, Blocked, NotPlayable };
+
+// Grid stored as bitboards: bit (row * columns + column) of each cell mask describes one cell,
+// with card ids packed alongside (GridBoard<Geometry>). Adds the Letter/Number and card interface
+// of the game; positions past E/5 address the extra rows and columns of larger geometries. Board is
+// the classic 5x5 instance. Trivially copyable, so board states can be copied with memcpy.
+template <class Geometry>
+class BasicBoard {
 public:
-    // Parameters: deck (DeckFactory<Card>&), storage (vector<unique_ptr<Card>>&). Builds grid from deck.
-    Board(DeckFactory<Card>& deck, std::vector<std::unique_ptr<Card>>& storage);
+    using Mask = typename Geometry::Mask;
+    using Ops = MaskOps<Mask>;
+    static constexpr std::size_t kRows = Geometry::kRows;
+    static constexpr std::size_t kColumns = Geometry::kColumns;
+    static constexpr std::size_t kCells = Geometry::kCells;
+
+    // Parameters: deck (DeckFactory<BasicCard<Geometry>, kCardCount>&). Builds grid from the next
+    // kCells - 1 cards of the deck.
+    explicit BasicBoard(DeckFactory<BasicCard<Geometry>, Geometry::kCardCount>& deck);
 
     // Parameters: letter (Letter), number (Number). Returns true if that slot is face up.
     bool isFaceUp(const Letter& letter, const Number& number) const;
@@ -22,10 +40,10 @@ public:
     bool turnFaceUp(const Letter& letter, const Number& number);
     // Parameters: letter (Letter), number (Number). Returns false when already face down.
     bool turnFaceDown(const Letter& letter, const Number& number);
-    // Parameters: letter (Letter), number (Number). Returns Card* pointing at the slot.
-    Card* getCard(const Letter& letter, const Number& number);
-    // Parameters: letter (Letter), number (Number), card (Card*). Replaces stored pointer.
-    void setCard(const Letter& letter, const Number& number, Card* card);
+    // Parameters: letter (Letter), number (Number). Returns the card stored in the slot.
+    BasicCard<Geometry> getCard(const Letter& letter, const Number& number) const;
+    // Parameters: letter (Letter), number (Number), card (Card). Places card in the slot.
+    void setCard(const Letter& letter, const Number& number, const BasicCard<Geometry>& card);
     // No parameters. Turns every occupied slot face down and clears block flags.
     void allFacesDown();
     // Parameters: letter (Letter), number (Number). Returns true if marked blocked.
@@ -39,25 +57,67 @@ public:
     // Parameters: first (Position), second (Position). Swaps underlying cells.
     void swapCells(const Position& first, const Position& second);
 
-    // No parameters. Returns vector pairs of Position and Card* for face-up cards.
-    std::vector<std::pair<Position, const Card*>> faceUpCards() const;
+    // Parameters: position (const Position&). Returns true if the position is on the board and holds a card.
+    // Never throws; use it to validate input before calling the unchecked accessors below.
+    bool isPlayable(const Position& position) const;
+    // Parameters: position (const Position&), blockActive (bool). Turns the card face up and returns
+    // FlipStatus::Flipped, or reports why it could not (never throws).
+    FlipStatus tryTurnFaceUp(const Position& position, bool blockActive = false);
 
-    // Streams either the full grid or empty-row placeholders depending on state.
-    friend std::ostream& operator<<(std::ostream& os, const Board& board);
+    // Unchecked accessors by cell index (see indexOf). The caller guarantees isPlayable for the cell.
+    BasicCard<Geometry> cardAt(std::size_t index) const {
+        return BasicCard<Geometry>::fromIdUnchecked(m_grid.cardAt(index));
+    }
+    bool isFaceUpAt(std::size_t index) const { return m_grid.isFaceUpAt(index); }
+    bool isBlockedAt(std::size_t index) const { return m_grid.isBlockedAt(index); }
+    void turnFaceUpAt(std::size_t index) { m_grid.turnFaceUpAt(index); }
+    void turnFaceDownAt(std::size_t index) { m_grid.turnFaceDownAt(index); }
+    void setCardAt(std::size_t index, const BasicCard<Geometry>& card) { m_grid.setCardAt(index, card.id()); }
+    // Parameters: index (std::size_t). Leaves that cell as the only blocked one.
+    void blockOnlyAt(std::size_t index) { m_grid.blockOnlyAt(index); }
+    // Parameters: first/second (std::size_t). Swaps cards and all per-cell flags of two cells.
+    void swapCellsAt(std::size_t first, std::size_t second) { m_grid.swapCellsAt(first, second); }
 
-private:
-    struct Cell {
-        Card* card{nullptr};
-        bool faceUp{false};
-        bool blocked{false};
-    };
+    // No parameters. Returns the packed card ids of every cell (the centre entry is unused).
+    const std::array<CardId, kCells>& cardIds() const { return m_grid.cards(); }
+    // Parameters: cards (card ids per cell), faceUp/blocked (cell masks). Replaces the whole layout,
+    // e.g. when restoring a GameSnapshot; ids are assumed valid and the centre bit is ignored.
+    void restoreState(const std::array<CardId, kCells>& cards, const Mask& faceUp, const Mask& blocked);
+
+    // No parameters. Returns vector pairs of Position and Card for face-up cards.
+    std::vector<std::pair<Position, BasicCard<Geometry>>> faceUpCards() const;
+    // Parameters: visit (callable taking Position, Card). Visits face-up cards in row-major order
+    // without allocating.
+    template <typename Visitor>
+    void forEachFaceUp(Visitor&& visit) const {
+        for (Mask mask = m_grid.faceUpMask(); Ops::any(mask); mask = Ops::dropLowest(mask)) {
+            const unsigned index = Ops::lowest(mask);
+            visit(positionOf(index), cardAt(index));
+        }
+    }
 
-    std::array<std::array<Cell, 5>, 5> m_grid{};
-    std::vector<std::unique_ptr<Card>>& m_cardStorage;
+    // Cell masks (bit = row * columns + column) for callers that work on whole-board sets.
+    Mask occupiedMask() const { return m_grid.occupiedMask(); }
+    Mask faceUpMask() const { return m_grid.faceUpMask(); }
+    Mask blockedMask() const { return m_grid.blockedMask(); }
+    Mask faceDownMask() const { return m_grid.faceDownMask(); }
+    // Parameters: blockActive (bool). Returns face-down cells, minus the blocked one when blockActive.
+    Mask flippableMask(bool blockActive) const { return m_grid.flippableMask(blockActive); }
+
+    // Parameters: position (const Position&). Returns its bit index (row * columns + column).
+    static std::size_t indexOf(const Position& position);
+    // Parameters: index (std::size_t, < kCells). Returns the matching Position.
+    static Position positionOf(std::size_t index);
+
+private:
+    GridBoard<Geometry> m_grid;
 
     static bool isCenter(Letter letter, Number number);
-    Cell& at(const Letter& letter, const Number& number);
-    const Cell& at(const Letter& letter, const Number& number) const;
+    // Parameters: letter (Letter), number (Number). Returns the cell index, throws OutOfRange for the centre.
+    static std::size_t at(const Letter& letter, const Number& number);
 };
 
+using Board = BasicBoard<ClassicGeometry>;
+
+// Streams the full classic grid (see FrameWriter::appendBoard).
 std::ostream& operator<<(std::ostream& os, const Board& board);
@@ -1,20 +1,32 @@
 #pragma once
 
 #include "Enums.h"
+#include "Geometry.h"
 
 #include <array>
+#include <cstdint>
 #include <iosfwd>
 #include <string>
 
-class CardDeck;
-
 // Represents a 3x3 ASCII depiction of a Memoarrr! card with animal + background.
-class Card {
+// A card is a one-byte value (its CardId in the alphabet of Geometry) and can be copied freely.
+// Card is the classic instance; the animals past Walrus of larger alphabets have no expert ability.
+template <class Geometry>
+class BasicCard {
 public:
-    Card(const Card&) = delete;
-    Card& operator=(const Card&) = delete;
-    Card(Card&&) noexcept = default;
-    Card& operator=(Card&&) noexcept = default;
+    // Number of distinct cards (one per animal/background combination); CardId is
+    // animal * backgrounds + background, so 0 to kCount - 1 covers the whole deck.
+    static constexpr std::size_t kCount = Geometry::kCardCount;
+
+    // Parameters: id (CardId, < kCount). Returns the card encoded by id.
+    static BasicCard fromId(CardId id);
+    // Parameters: id (CardId, must be < kCount). Same as fromId without the range check.
+    static BasicCard fromIdUnchecked(CardId id) {
+        return BasicCard(id);
+    }
+
+    // No parameters. Returns the packed animal/background identifier.
+    CardId id() const;
 
     // Number of drawable rows (always 3) for board rendering loops.
     std::size_t getNRows() const;
@@ -26,14 +38,15 @@ public:
     // Implicit conversion exposing the card background colour.
     operator FaceBackground() const;
 
-private:
-    Card(FaceAnimal animal, FaceBackground background);
+    bool operator==(const BasicCard& other) const;
+    bool operator!=(const BasicCard& other) const;
 
-    FaceAnimal m_animal;
-    FaceBackground m_background;
+private:
+    explicit BasicCard(CardId id);
 
-    friend class CardDeck;
-    friend std::ostream& operator<<(std::ostream&, const Card&);
+    CardId m_id;
 };
 
+using Card = BasicCard<ClassicGeometry>;
+
 std::ostream& operator<<(std::ostream& os, const Card& card);
@@ -3,17 +3,24 @@
 #include "Card.h"
 #include "DeckFactory.h"
 
-// Singleton deck factory responsible for producing the 25 animal/background cards.
-class CardDeck : public DeckFactory<Card> {
+// Deck of every card of a geometry's alphabet, built in id order (animal-major) and shuffled and
+// drawn through DeckFactory; deals the board of a BasicGame<Geometry>.
+template <class Geometry>
+class GridDeck : public DeckFactory<BasicCard<Geometry>, Geometry::kCardCount> {
 public:
-    // Returns the single instance used throughout gameplay.
-    static CardDeck& make_CardDeck();
+    GridDeck() {
+        for (std::size_t id = 0; id < Geometry::kCardCount; ++id) {
+            this->add(BasicCard<Geometry>::fromIdUnchecked(static_cast<CardId>(id)));
+        }
+    }
 
-    // Rebuilds the deck back to a full 25-card state (used before each game).
-    void reset();
+    // Returns every card to the deck in its initial order (used before each game; no allocation).
+    void reset() { this->refill(); }
+};
 
-private:
-    CardDeck();
-    // Populates the deck with all combinations of animal/background pairs.
-    void build();
+// Deck factory responsible for producing the 25 animal/background cards of the classic game.
+class CardDeck : public GridDeck<ClassicGeometry> {
+public:
+    // Returns the shared instance used by the interactive game.
+    static CardDeck& make_CardDeck();
 };
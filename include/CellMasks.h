@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Enums.h"
+#include "Geometry.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Compile-time lookup tables for the classic 5x5 grid (ClassicGeometry). Bit (row * 5 + column)
+// of a mask stands for one cell, the same layout as Board's bitboards, so adjacency tests and
+// target enumeration are a table load and a few bit operations with no allocation.
+
+constexpr std::size_t kGridRows = ClassicGeometry::kRows;
+constexpr std::size_t kGridColumns = ClassicGeometry::kColumns;
+constexpr std::size_t kGridCells = ClassicGeometry::kCells;
+
+using ClassicTables = GridTables<ClassicGeometry>;
+static_assert(std::is_same<ClassicGeometry::Mask, std::uint32_t>::value, "The classic board fits 32-bit masks");
+
+static_assert(ClassicTables::kMasks.neighbours[0] == 0x22u, "A1 touches A2 and B1");
+static_assert(ClassicTables::kMasks.neighbours[12] == 0x22880u, "C3 touches B3, C2, C4 and D3");
+static_assert(ClassicTables::kMasks.fronts[static_cast<std::size_t>(Side::Right)] == 0x84200u,
+              "Right peeks at B5, C5 and D5");
+
+// Parameters: position (const Position&). Returns the cell index row * 5 + column.
+constexpr std::size_t cell_index(const Position& position) {
+    return static_cast<std::size_t>(position.letter) * kGridColumns + static_cast<std::size_t>(position.number);
+}
+
+// Parameters: index (std::size_t, < kGridCells). Returns the cells orthogonally adjacent to it.
+constexpr std::uint32_t neighbour_mask(std::size_t index) {
+    return ClassicTables::kMasks.neighbours[index];
+}
+
+// Parameters: side (Side). Returns the three cells a player on that side peeks at each round.
+constexpr std::uint32_t front_mask(Side side) {
+    return ClassicTables::kMasks.fronts[static_cast<std::size_t>(side)];
+}
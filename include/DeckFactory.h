@@ -1,51 +1,111 @@
 #pragma once
 
-#include <algorithm>
-#include <memory>
-#include <vector>
+#include "Random.h"
 
-template <typename C>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Deck of at most N elements held in an inline pool. Elements are constructed once (add) and
+// never freed before the deck; shuffle, draw and refill only permute slot indices, so a deck
+// never touches the heap after construction. getNext lends elements instead of giving them away.
+template <typename C, std::size_t N>
 class DeckFactory {
 public:
-    virtual ~DeckFactory() = default;
+    static_assert(N <= 256, "Slot indices are stored as bytes");
+
+    static constexpr std::size_t kCapacity = N;
+
+    virtual ~DeckFactory() {
+        for (std::size_t slot = 0; slot < m_built; ++slot) {
+            element(slot).~C();
+        }
+    }
 
-    // No parameters. Randomizes the ordering of the deck contents using std::random_shuffle.
+    DeckFactory(const DeckFactory&) = delete;
+    DeckFactory& operator=(const DeckFactory&) = delete;
+
+    // No parameters. Randomizes the ordering with a Fisher-Yates pass driven by the deck's own generator.
     void shuffle() {
-        std::random_shuffle(m_cards.begin(), m_cards.end());
+        for (std::size_t i = m_size; i > 1; --i) {
+            const std::size_t j = m_rng.bounded(static_cast<std::uint32_t>(i));
+            std::swap(m_order[i - 1], m_order[j]);
+        }
     }
 
-    // No parameters. Removes and returns ownership of the next element, nullptr when empty.
-    C* getNext() {
-        if (m_cards.empty()) {
+    // Parameters: seed (std::uint64_t). Restarts the deck's generator so later shuffles are reproducible.
+    void seed(std::uint64_t seed) {
+        m_rng.reseed(seed);
+    }
+
+    // Parameters: rng (const Xoshiro256&). Adopts a generator state, e.g. a stream from Xoshiro256::split().
+    void setGenerator(const Xoshiro256& rng) {
+        m_rng = rng;
+    }
+
+    // No parameters. Returns the generator driving shuffle() (for snapshots and diagnostics).
+    const Xoshiro256& generator() const {
+        return m_rng;
+    }
+
+    // No parameters. Draws the next element, nullptr when empty. The deck keeps ownership: the
+    // element stays valid and unchanged for the deck's lifetime (a refill only makes it drawable again).
+    const C* getNext() {
+        if (m_size == 0) {
             return nullptr;
         }
-        std::unique_ptr<C> next = std::move(m_cards.back());
-        m_cards.pop_back();
-        return next.release();
+        return &element(m_order[--m_size]);
     }
 
     // No parameters. Returns true if no cards/rubies remain to draw.
     bool isEmpty() const {
-        return m_cards.empty();
+        return m_size == 0;
     }
 
     // No parameters. Returns the current collection size for diagnostics.
     std::size_t size() const {
-        return m_cards.size();
+        return m_size;
     }
 
 protected:
     DeckFactory() = default;
 
-    // Parameters: value (std::unique_ptr<C>). Adds freshly constructed object to storage.
-    void push(std::unique_ptr<C> value) {
-        m_cards.push_back(std::move(value));
+    // Parameters: value (C&&). Moves value into the next pool slot and makes it drawable.
+    // Throws std::length_error once N elements exist.
+    void add(C&& value) {
+        if (m_built == N) {
+            throw std::length_error("Deck pool is full");
+        }
+        new (&m_storage[m_built]) C(std::move(value));
+        m_order[m_size++] = static_cast<std::uint8_t>(m_built++);
     }
 
-    // No parameters. Clears the container without deleting shared storage (used by reset routines).
-    void clear() {
-        m_cards.clear();
+    // No parameters. Makes every pooled element drawable again, in the order they were added.
+    void refill() {
+        for (std::size_t slot = 0; slot < m_built; ++slot) {
+            m_order[slot] = static_cast<std::uint8_t>(slot);
+        }
+        m_size = m_built;
     }
 
-    std::vector<std::unique_ptr<C>> m_cards;
+    // Parameters: slot (std::size_t, < number of added elements). Returns the pooled element.
+    const C& element(std::size_t slot) const {
+        return *reinterpret_cast<const C*>(&m_storage[slot]);
+    }
+    C& element(std::size_t slot) {
+        return *reinterpret_cast<C*>(&m_storage[slot]);
+    }
+
+    // Slots still to be drawn; the next draw is m_order[m_size - 1].
+    std::array<std::uint8_t, N> m_order{};
+    std::size_t m_size{0};
+    std::size_t m_built{0};
+    Xoshiro256 m_rng;
+
+private:
+    typename std::aligned_storage<sizeof(C), alignof(C)>::type m_storage[N];
 };
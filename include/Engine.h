@@ -0,0 +1,177 @@
+#pragma once
+
+#include "Agent.h"
+#include "Game.h"
+#include "GameObserver.h"
+#include "RubisDeck.h"
+#include "Rules.h"
+#include "Snapshot.h"
+
+#include <cstddef>
+#include <vector>
+
+// Decision the engine is waiting for when advance() returns (None once the game is over).
+enum class InputKind { None, Flip, OctopusTarget, PenguinTarget, WalrusBlock };
+
+// Describes a pending decision. options lists the legal octopus/penguin targets (optionMask holds the
+// same cells); flips and walrus blocks accept any position for which Engine::canFlip(position, blockActive) holds.
+// InputRequest is the classic 5x5 instance.
+template <class Geometry>
+struct BasicInputRequest {
+    InputKind kind{InputKind::None};
+    std::size_t player{0};
+    bool blockActive{false};
+    // Card whose ability is being resolved (octopus and penguin).
+    Position origin{Letter::A, Number::One};
+    std::vector<Position> options;
+    typename Geometry::Mask optionMask{};
+};
+
+using InputRequest = BasicInputRequest<ClassicGeometry>;
+
+// Headless match driver on a Geometry board: sequences turns, eliminations, expert abilities and ruby
+// awards. Engine plays the classic 5x5 game; GameEngine<Geometry7x7> and GameEngine<Geometry9x9> run the
+// same turn flow on the stress boards. The turn flow is a resumable state machine. Seats with an Agent
+// are answered immediately; for other seats advance() returns an InputRequest and the caller feeds the
+// answer later through the matching submit* call, so one thread can drive any number of tables.
+// All feedback goes to registered GameObservers.
+// The turn loop is compiled per rules policy (RulesPolicy.h): an Engine picks BaseRules or
+// ExpertRules from game.rulesMode() once, BasicEngine<Policy> fixes the policy at compile time.
+template <class Geometry>
+class GameEngine {
+public:
+    using Mask = typename Geometry::Mask;
+    using Request = BasicInputRequest<Geometry>;
+
+    // Parameters: game (BasicGame<Geometry>&), rules (const Rules&), rubisDeck (RubisDeck&). Objects must
+    // outlive the engine.
+    GameEngine(BasicGame<Geometry>& game, const Rules& rules, RubisDeck& rubisDeck);
+    GameEngine(const GameEngine&) = delete;
+    GameEngine& operator=(const GameEngine&) = delete;
+
+    // Parameters: playerIndex (std::size_t), agent (BasicAgent<Geometry>&). Assigns the decision source for
+    // a seat.
+    void setAgent(std::size_t playerIndex, BasicAgent<Geometry>& agent);
+    // Parameters: observer (BasicGameObserver<Geometry>&). Registers a listener for engine events.
+    void addObserver(BasicGameObserver<Geometry>& observer);
+
+    // No parameters. Plays rounds until Rules::gameOver, then publishes GameEnd.
+    // Every seat needs an Agent; throws std::logic_error otherwise.
+    void playGame();
+    // No parameters. Plays one full round including the peek phase and ruby award (agents only).
+    void playRound();
+
+    // No parameters. Runs the game until a seat without an Agent must decide, or the game ends.
+    // Returns the pending request (kind None when finished); valid until the next engine call.
+    const Request& advance();
+    // No parameters. Returns the request advance() last stopped on.
+    const Request& pending() const;
+    // No parameters. Returns true once GameEnd has been published.
+    bool finished() const;
+
+    // Answers for the pending request. Each returns false, leaving the request pending, when the
+    // answer is illegal; throws std::logic_error when the engine is waiting for something else.
+    // Call advance() afterwards to continue.
+    bool submitFlip(const Position& position);
+    bool submitOctopusTarget(const Position& target);
+    // Parameters: flipDown (bool) false to skip the ability, target (const Position&).
+    bool submitPenguinTarget(bool flipDown, const Position& target);
+    // Parameters: block (bool) false to skip the ability, target (const Position&).
+    bool submitWalrusBlock(bool block, const Position& target);
+
+    // No parameters. Returns the full match state: game, ruby deck, turn position and pending effects.
+    // Classic board only. Throws std::invalid_argument on tables of more than GameSnapshot::kMaxPlayers
+    // seats, whose seat masks and carried-over turn order a snapshot cannot hold.
+    GameSnapshot snapshot() const;
+    // Parameters: snapshot (const GameSnapshot&). Puts the game, ruby deck and engine back in that state.
+    // Classic board only. Throws std::invalid_argument if it is malformed or was taken with a different
+    // number of players.
+    void restore(const GameSnapshot& snapshot);
+
+    // Parameters: position (const Position&), blockActive (bool). Returns true if the card may be flipped.
+    bool canFlip(const Position& position, bool blockActive) const;
+    // Parameters: origin (const Position&). Returns the cell mask of cards the octopus at origin may swap with.
+    Mask octopusTargets(const Position& origin) const;
+    // Parameters: current (const Position&). Returns the cell mask of face-up cards the penguin may turn face down.
+    Mask penguinTargets(const Position& current) const;
+
+protected:
+    // Selects the turn loop instantiated for Policy (defined in BasicEngine.h).
+    template <class Policy>
+    void usePolicy();
+
+private:
+    // Where the turn flow stands; the decision phases match InputKind.
+    enum class Phase {
+        NotStarted,
+        RoundStart,
+        TurnStart,
+        Flip,
+        Octopus,
+        Penguin,
+        Walrus,
+        AfterFlip,
+        EndTurn,
+        RoundEnd,
+        GameEnd,
+        Finished
+    };
+
+    // Policy-specific turn flow (BasicEngine.h); reached through the pointers below.
+    template <class Policy>
+    const Request& advanceWith();
+    template <class Policy>
+    bool stepWith();
+    template <class Policy>
+    bool flipWith(const Position& choice);
+    template <class Policy>
+    void startAbility(const Position& position);
+
+    void startRound();
+    void startTurn();
+    bool askOctopus();
+    bool askPenguin();
+    bool askWalrus();
+    bool resolveOctopus(const Position& target);
+    bool resolvePenguin(bool flipDown, const Position& target);
+    bool resolveWalrus(bool block, const Position& target);
+    void finishRound();
+    void await(Phase phase, Mask options = Mask{});
+    void expect(Phase phase) const;
+
+    void resetRound();
+    void revealInitialCards();
+    void awardRubies();
+    bool hasFlippableCard(bool blockActive) const;
+    bool hasAgent(std::size_t playerIndex) const;
+    BasicAgent<Geometry>& agentFor(std::size_t playerIndex);
+    static GameEvent makeEvent(EventType type, std::size_t player = 0);
+    GameEvent abilityEvent(EventType type) const;
+    void emit(const GameEvent& event);
+
+    BasicGame<Geometry>& m_game;
+    const Rules& m_rules;
+    RubisDeck& m_rubisDeck;
+    std::vector<BasicAgent<Geometry>*> m_agents;
+    std::vector<BasicGameObserver<Geometry>*> m_observers;
+    const Request& (GameEngine::*m_advance)(){nullptr};
+    bool (GameEngine::*m_step)(){nullptr};
+    bool (GameEngine::*m_flip)(const Position&){nullptr};
+    Phase m_phase{Phase::NotStarted};
+    std::size_t m_turnIndex{0};
+    // Last seat that got to flip; on large tables the next round opens after it (see startRound).
+    std::size_t m_lastTurn{0};
+    Position m_abilityOrigin{Letter::A, Number::One};
+    Request m_request;
+    bool m_extraFlip{false};
+    bool m_walrusBlockPending{false};
+    bool m_walrusBlockActive{false};
+    int m_skipCount{0};
+};
+
+using Engine = GameEngine<ClassicGeometry>;
+
+template <>
+GameSnapshot Engine::snapshot() const;
+template <>
+void Engine::restore(const GameSnapshot& snapshot);
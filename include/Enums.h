@@ -2,7 +2,6 @@
 
 #include <cstddef>
 #include <string>
-#include <vector>
 
 // Enumerations representing animals, backgrounds, seating sides, and board axes.
 enum class FaceAnimal { Crab, Penguin, Octopus, Turtle, Walrus };
@@ -26,6 +25,8 @@ std::string to_string(FaceAnimal animal);
 std::string to_string(FaceBackground background);
 // Parameters: side (Side). Returns lowercase description of seating side.
 std::string to_string(Side side);
+// Parameters: side (Side). Same text as to_string(Side) without allocating.
+const char* side_name(Side side);
 // Parameters: background (FaceBackground). Returns the char symbol (r/g/p/b/y).
 char background_symbol(FaceBackground background);
 // Parameters: animal (FaceAnimal). Returns capital letter symbol.
@@ -34,13 +35,15 @@ char animal_symbol(FaceAnimal animal);
 char letter_symbol(Letter letter);
 // Parameters: number (Number). Returns board number label (1-5).
 char number_symbol(Number number);
+// Parameters: begin/end (const char*) the text, position (Position&) output. Returns true when the
+// text is exactly a board label "A1".."E5" (letters in either case); position is untouched otherwise.
+bool parse_position(const char* begin, const char* end, Position& position);
 // Parameters: letter (Letter). Returns zero-based row index.
 std::size_t to_index(Letter letter);
 // Parameters: number (Number). Returns zero-based column index.
 std::size_t to_index(Number number);
-// Parameters: origin (const Position&). Returns vector of orthogonal neighbour positions.
-std::vector<Position> orthogonal_neighbours(const Position& origin);
-// Parameters: lhs (const Position&), rhs (const Position&). Returns true if orthogonally adjacent.
+// Parameters: lhs (const Position&), rhs (const Position&). Returns true if orthogonally adjacent
+// (a lookup in the neighbour masks of CellMasks.h).
 bool is_adjacent(const Position& lhs, const Position& rhs);
 // Parameters: lhs/rhs (const Position&). Returns true if both coordinates match.
 bool operator==(const Position& lhs, const Position& rhs);
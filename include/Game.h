@@ -5,74 +5,113 @@
 #include "Enums.h"
 #include "Player.h"
 
-#include <memory>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
+struct GameSnapshot;
+
 // Configuration flags chosen at startup indicating display and rules variants.
 struct GameOptions {
     DisplayMode displayMode{DisplayMode::Base};
     RulesMode rulesMode{RulesMode::Base};
 };
 
-class Game {
+// Board, roster and turn state of one match on a Geometry board. Game is the classic 5x5 instance;
+// only it can be saved to a GameSnapshot or printed.
+template <class Geometry>
+class BasicGame {
 public:
-    // Parameters: cardDeck (DeckFactory<Card>&), options (GameOptions). Owns board/players.
-    Game(DeckFactory<Card>& cardDeck, const GameOptions& options);
+    using Mask = typename Geometry::Mask;
+
+    // Parameters: cardDeck (DeckFactory<BasicCard<Geometry>, kCardCount>&), options (GameOptions). Owns
+    // board/players; the board only records card ids, so the deck may be reset while the game lives.
+    BasicGame(DeckFactory<BasicCard<Geometry>, Geometry::kCardCount>& cardDeck, const GameOptions& options);
 
     // No parameters. Returns current round number (int).
     int getRound() const;
     // No parameters. Increments the internal round counter.
     void incrementRound();
 
-    // Parameters: player (const Player&). Copies player into roster.
+    // Parameters: player (const Player&). Copies player into roster (at most kMaxSeats, see Seating.h).
     void addPlayer(const Player& player);
-    // Parameters: side (Side). Returns reference to player seated on that side.
+    // Parameters: side (Side). Returns reference to player seated on that side. Throws std::logic_error
+    // on tables of more than kClassicSeats, where several seats share a side; index players() instead.
     Player& getPlayer(Side side);
     // No parameters. Returns const view of player vector.
     const std::vector<Player>& players() const;
     // No parameters. Returns mutable view of player vector.
     std::vector<Player>& players();
 
-    // No parameters. Returns pointer to previous/ current cards for rule checks.
-    const Card* getPreviousCard() const;
-    const Card* getCurrentCard() const;
-    // Parameters: card (const Card*). Updates current and previous pointers.
-    void setCurrentCard(const Card* card);
+    // No parameters. Returns pointer to previous/ current cards for rule checks (nullptr when none).
+    const BasicCard<Geometry>* getPreviousCard() const;
+    const BasicCard<Geometry>* getCurrentCard() const;
+    // Parameters: card (const BasicCard<Geometry>&). Shifts current to previous and stores a copy of card.
+    void setCurrentCard(const BasicCard<Geometry>& card);
 
-    // Parameters: letter (Letter), number (Number). Forwards to Board::getCard.
-    Card* getCard(const Letter& letter, const Number& number);
-    // Parameters: letter (Letter), number (Number), card (Card*). Forwards to Board::setCard.
-    void setCard(const Letter& letter, const Number& number, Card* card);
+    // Parameters: letter (Letter), number (Number). Forwards to BasicBoard::getCard.
+    BasicCard<Geometry> getCard(const Letter& letter, const Number& number) const;
+    // Parameters: letter (Letter), number (Number), card (BasicCard<Geometry>). Forwards to BasicBoard::setCard.
+    void setCard(const Letter& letter, const Number& number, const BasicCard<Geometry>& card);
 
     // No parameters. Returns references to the owned board instance.
-    Board& board();
-    const Board& board() const;
+    BasicBoard<Geometry>& board();
+    const BasicBoard<Geometry>& board() const;
 
     // No parameters. Returns the display and rules modes that were selected.
     DisplayMode displayMode() const;
     RulesMode rulesMode() const;
 
+    // Parameters: seat (std::size_t), active (bool). Marks a seat in or out of the current round. Use this
+    // rather than Player::setActive so that the active-seat mask stays in step with the players.
+    void setPlayerActive(std::size_t seat, bool active);
+    // No parameters. Marks every seat active (start of a round).
+    void activateAllPlayers();
+    // No parameters. Returns the seats still in the round, one bit per seat.
+    std::uint32_t activeMask() const;
+    // No parameters. Returns how many seats are still in the round.
+    std::size_t activeCount() const;
+    // Parameters: seat (std::size_t). Returns the next active seat after it in turn order, wrapping
+    // around (seat itself when it is the only one left, or when nobody is active).
+    std::size_t nextActivePlayer(std::size_t seat) const;
+
     // Parameters: index (std::size_t). Assigns/reads the active player index.
     void setCurrentPlayerIndex(std::size_t index);
     std::size_t currentPlayerIndex() const;
     // No parameters. Returns Player& for currently tracked player.
     Player& currentPlayer();
 
-    // No parameters. Clears previous/current card pointers and player index.
+    // No parameters. Clears previous/current cards and player index.
     void resetTurnPointers();
 
-    // Prints the board (or expert row) followed by player summaries.
-    friend std::ostream& operator<<(std::ostream& os, const Game& game);
+    // Parameters: snapshot (GameSnapshot&). Stores board, turn cards, round and per-seat state. Classic
+    // board only. Throws std::invalid_argument on tables of more than GameSnapshot::kMaxPlayers seats.
+    void saveState(GameSnapshot& snapshot) const;
+    // Parameters: snapshot (const GameSnapshot&). Restores what saveState stored. The roster must
+    // already hold snapshot.playerCount players; throws std::invalid_argument otherwise.
+    void restoreState(const GameSnapshot& snapshot);
 
 private:
-    std::vector<std::unique_ptr<Card>> m_cardStorage;
-    Board m_board;
+    BasicBoard<Geometry> m_board;
     std::vector<Player> m_players;
+    // Bit i set while m_players[i] is active; kept in step by setPlayerActive/activateAllPlayers.
+    std::uint32_t m_activeMask{0};
     int m_round{0};
-    const Card* m_previousCard{nullptr};
-    const Card* m_currentCard{nullptr};
+    // Cards are stored by value so that board swaps never change what was revealed.
+    BasicCard<Geometry> m_previousCard{BasicCard<Geometry>::fromIdUnchecked(0)};
+    BasicCard<Geometry> m_currentCard{BasicCard<Geometry>::fromIdUnchecked(0)};
+    bool m_hasPreviousCard{false};
+    bool m_hasCurrentCard{false};
     GameOptions m_options;
     std::size_t m_currentPlayer{0};
 };
 
+using Game = BasicGame<ClassicGeometry>;
+
+template <>
+void Game::saveState(GameSnapshot& snapshot) const;
+template <>
+void Game::restoreState(const GameSnapshot& snapshot);
+
+// Prints the board (or expert row) followed by player summaries.
 std::ostream& operator<<(std::ostream& os, const Game& game);
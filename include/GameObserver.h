@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Enums.h"
+#include "Game.h"
+
+#include <cstddef>
+
+// Kinds of notifications published by the Engine while a match progresses.
+enum class EventType {
+    GameStart,
+    RoundStart,
+    Peek,
+    Skipped,
+    NoCardsLeft,
+    BlockEnforced,
+    Flip,
+    Mismatch,
+    OctopusSwap,
+    OctopusNoTarget,
+    PenguinFlipDown,
+    PenguinSkipped,
+    PenguinNoPrevious,
+    PenguinNoTarget,
+    WalrusBlock,
+    WalrusSkipped,
+    CrabExtraFlip,
+    TurtleSkip,
+    RubyAwarded,
+    NoRubies,
+    NoWinner,
+    RoundEnd,
+    GameEnd
+};
+
+// Describes one engine event. Fields that do not apply to the event type are left at defaults.
+struct GameEvent {
+    EventType type{EventType::GameStart};
+    std::size_t player{0};
+    Position position{Letter::A, Number::One};
+    Position target{Letter::A, Number::One};
+    int value{0};
+};
+
+// Receives engine events of a game on a Geometry board; used for console output, logging and
+// statistics. GameObserver is the classic 5x5 instance.
+template <class Geometry>
+class BasicGameObserver {
+public:
+    virtual ~BasicGameObserver() = default;
+
+    // Parameters: game (const BasicGame<Geometry>&) state after the event was applied, event (const GameEvent&).
+    virtual void onEvent(const BasicGame<Geometry>& game, const GameEvent& event) = 0;
+};
+
+using GameObserver = BasicGameObserver<ClassicGeometry>;
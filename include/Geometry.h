@@ -0,0 +1,242 @@
+#pragma once
+
+#include "Bits.h"
+#include "Enums.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Compile-time board geometry: grid size, centre hole and card alphabet, plus the cell-mask type
+// and lookup tables derived from them. The classic 5x5 game (ClassicGeometry) and the larger
+// stress variants share this code; cell index = row * columns + column throughout.
+
+// Packed card identifier: animal * backgrounds + background.
+using CardId = std::uint8_t;
+
+// Cell set wider than 64 bits, stored as little-endian 64-bit words.
+template <std::size_t Words>
+struct WideMask {
+    std::uint64_t words[Words];
+};
+
+template <std::size_t Words>
+constexpr WideMask<Words> operator&(WideMask<Words> lhs, const WideMask<Words>& rhs) {
+    for (std::size_t i = 0; i < Words; ++i) {
+        lhs.words[i] &= rhs.words[i];
+    }
+    return lhs;
+}
+
+template <std::size_t Words>
+constexpr WideMask<Words> operator|(WideMask<Words> lhs, const WideMask<Words>& rhs) {
+    for (std::size_t i = 0; i < Words; ++i) {
+        lhs.words[i] |= rhs.words[i];
+    }
+    return lhs;
+}
+
+template <std::size_t Words>
+constexpr WideMask<Words> operator^(WideMask<Words> lhs, const WideMask<Words>& rhs) {
+    for (std::size_t i = 0; i < Words; ++i) {
+        lhs.words[i] ^= rhs.words[i];
+    }
+    return lhs;
+}
+
+template <std::size_t Words>
+constexpr WideMask<Words> operator~(WideMask<Words> mask) {
+    for (std::size_t i = 0; i < Words; ++i) {
+        mask.words[i] = ~mask.words[i];
+    }
+    return mask;
+}
+
+template <std::size_t Words>
+constexpr bool operator==(const WideMask<Words>& lhs, const WideMask<Words>& rhs) {
+    for (std::size_t i = 0; i < Words; ++i) {
+        if (lhs.words[i] != rhs.words[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <std::size_t Words>
+constexpr bool operator!=(const WideMask<Words>& lhs, const WideMask<Words>& rhs) {
+    return !(lhs == rhs);
+}
+
+// Single-cell and scanning operations for every mask type, so grid code is written once.
+template <typename Mask>
+struct MaskOps {
+    static_assert(std::is_unsigned<Mask>::value, "Cell masks are unsigned integers or WideMask");
+
+    static constexpr Mask bit(std::size_t index) { return static_cast<Mask>(Mask{1} << index); }
+    static constexpr bool test(Mask mask, std::size_t index) { return (mask >> index) & 1u; }
+    static constexpr bool any(Mask mask) { return mask != 0; }
+    static unsigned lowest(Mask mask) { return count_trailing_zeros(mask); }
+    static constexpr Mask dropLowest(Mask mask) { return static_cast<Mask>(mask & (mask - 1)); }
+    static unsigned count(Mask mask) { return popcount(mask); }
+};
+
+template <std::size_t Words>
+struct MaskOps<WideMask<Words>> {
+    using Mask = WideMask<Words>;
+
+    static constexpr Mask bit(std::size_t index) {
+        Mask mask{};
+        mask.words[index / 64] = std::uint64_t{1} << (index % 64);
+        return mask;
+    }
+    static constexpr bool test(const Mask& mask, std::size_t index) {
+        return (mask.words[index / 64] >> (index % 64)) & 1u;
+    }
+    static constexpr bool any(const Mask& mask) {
+        for (std::size_t i = 0; i < Words; ++i) {
+            if (mask.words[i] != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+    // Parameters: mask (non-empty). Returns the lowest cell index in it.
+    static unsigned lowest(const Mask& mask) {
+        std::size_t i = 0;
+        while (mask.words[i] == 0) {
+            ++i;
+        }
+        return static_cast<unsigned>(i * 64) + count_trailing_zeros(mask.words[i]);
+    }
+    static constexpr Mask dropLowest(Mask mask) {
+        for (std::size_t i = 0; i < Words; ++i) {
+            if (mask.words[i] != 0) {
+                mask.words[i] &= mask.words[i] - 1;
+                break;
+            }
+        }
+        return mask;
+    }
+    static unsigned count(const Mask& mask) {
+        unsigned total = 0;
+        for (std::size_t i = 0; i < Words; ++i) {
+            total += popcount(mask.words[i]);
+        }
+        return total;
+    }
+};
+
+// Parameters: mask (non-empty), n (unsigned, below the number of cells in mask). Returns the index of
+// the n-th lowest cell of the mask.
+template <typename Mask>
+unsigned nth_cell(Mask mask, unsigned n) {
+    using Ops = MaskOps<Mask>;
+    while (n-- > 0) {
+        mask = Ops::dropLowest(mask);
+    }
+    return Ops::lowest(mask);
+}
+
+// Smallest mask type holding one bit per cell: 32 bits for the classic board, 64 for 7x7,
+// WideMask beyond that.
+template <std::size_t Cells>
+using CellMask = typename std::conditional<
+    Cells <= 32, std::uint32_t,
+    typename std::conditional<Cells <= 64, std::uint64_t, WideMask<(Cells + 63) / 64>>::type>::type;
+
+// Rows x Columns grid with an empty centre cell, dealt from Animals x Backgrounds distinct cards.
+template <std::size_t Rows, std::size_t Columns, std::size_t Animals, std::size_t Backgrounds>
+struct BoardGeometry {
+    static constexpr std::size_t kRows = Rows;
+    static constexpr std::size_t kColumns = Columns;
+    static constexpr std::size_t kCells = Rows * Columns;
+    static constexpr std::size_t kCenter = (Rows / 2) * Columns + Columns / 2;
+    static constexpr std::size_t kAnimals = Animals;
+    static constexpr std::size_t kBackgrounds = Backgrounds;
+    static constexpr std::size_t kCardCount = Animals * Backgrounds;
+
+    static_assert(Rows % 2 == 1 && Columns % 2 == 1 && Rows >= 3 && Columns >= 3,
+                  "The centre hole needs odd dimensions of at least 3");
+    static_assert(kCardCount >= kCells - 1, "Every cell but the centre needs a distinct card");
+    static_assert(kCardCount <= 256, "Card ids are one byte");
+
+    using Mask = CellMask<kCells>;
+
+    // Parameters: animal/background (std::size_t). Returns the packed card id.
+    static constexpr CardId cardId(std::size_t animal, std::size_t background) {
+        return static_cast<CardId>(animal * Backgrounds + background);
+    }
+    static constexpr std::size_t animalOf(CardId id) { return id / Backgrounds; }
+    static constexpr std::size_t backgroundOf(CardId id) { return id % Backgrounds; }
+    // Parameters: previous/current (CardId). Returns true when the animal or the background agrees.
+    static constexpr bool matches(CardId previous, CardId current) {
+        return animalOf(previous) == animalOf(current) || backgroundOf(previous) == backgroundOf(current);
+    }
+};
+
+// The published game: 5x5 grid, five animals on five backgrounds.
+using ClassicGeometry = BoardGeometry<5, 5, 5, 5>;
+// Stress variants: 7x7 with 48 cards (6 animals x 8 backgrounds), 9x9 with 80 (8 x 10).
+using Geometry7x7 = BoardGeometry<7, 7, 6, 8>;
+using Geometry9x9 = BoardGeometry<9, 9, 8, 10>;
+
+// Per-cell lookup tables of one geometry.
+template <class Geometry>
+struct GridMasks {
+    using Mask = typename Geometry::Mask;
+
+    // Orthogonally adjacent cells of every cell.
+    Mask neighbours[Geometry::kCells];
+    // Cells a seat peeks at, indexed by Side (Top, Bottom, Left, Right): its edge without the corners.
+    Mask fronts[4];
+};
+
+// Description: Builds the neighbour and front tables of a geometry at compile time.
+// Returns: GridMasks<Geometry>.
+template <class Geometry>
+constexpr GridMasks<Geometry> make_grid_masks() {
+    using Ops = MaskOps<typename Geometry::Mask>;
+    constexpr std::size_t rows = Geometry::kRows;
+    constexpr std::size_t columns = Geometry::kColumns;
+    GridMasks<Geometry> table{};
+    for (std::size_t index = 0; index < Geometry::kCells; ++index) {
+        const std::size_t row = index / columns;
+        const std::size_t col = index % columns;
+        auto mask = typename Geometry::Mask{};
+        if (row > 0) {
+            mask = mask | Ops::bit(index - columns);
+        }
+        if (row + 1 < rows) {
+            mask = mask | Ops::bit(index + columns);
+        }
+        if (col > 0) {
+            mask = mask | Ops::bit(index - 1);
+        }
+        if (col + 1 < columns) {
+            mask = mask | Ops::bit(index + 1);
+        }
+        table.neighbours[index] = mask;
+    }
+    for (std::size_t col = 1; col + 1 < columns; ++col) {
+        table.fronts[static_cast<std::size_t>(Side::Top)] =
+            table.fronts[static_cast<std::size_t>(Side::Top)] | Ops::bit(col);
+        table.fronts[static_cast<std::size_t>(Side::Bottom)] =
+            table.fronts[static_cast<std::size_t>(Side::Bottom)] | Ops::bit((rows - 1) * columns + col);
+    }
+    for (std::size_t row = 1; row + 1 < rows; ++row) {
+        table.fronts[static_cast<std::size_t>(Side::Left)] =
+            table.fronts[static_cast<std::size_t>(Side::Left)] | Ops::bit(row * columns);
+        table.fronts[static_cast<std::size_t>(Side::Right)] =
+            table.fronts[static_cast<std::size_t>(Side::Right)] | Ops::bit(row * columns + columns - 1);
+    }
+    return table;
+}
+
+// One shared instance of the tables per geometry.
+template <class Geometry>
+struct GridTables {
+    static constexpr GridMasks<Geometry> kMasks = make_grid_masks<Geometry>();
+};
+
+template <class Geometry>
+constexpr GridMasks<Geometry> GridTables<Geometry>::kMasks;
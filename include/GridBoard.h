@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Geometry.h"
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+// Bitboard state of one grid: a card id per cell plus occupied, face-up and blocked cell masks.
+// Indices are unchecked (callers validate positions first); trivially copyable for any geometry.
+// BasicBoard wraps it with the Position and card interface of the game.
+template <class Geometry>
+class GridBoard {
+public:
+    using Mask = typename Geometry::Mask;
+    using Ops = MaskOps<Mask>;
+    static constexpr std::size_t kCells = Geometry::kCells;
+
+    // Parameters: draw (callable taking CardId& and returning false once no card is left). Places
+    // one card on every cell but the centre, row-major. Returns false if draw ran out of cards.
+    template <typename Draw>
+    bool deal(Draw&& draw) {
+        m_occupied = Mask{};
+        m_faceUp = Mask{};
+        m_blocked = Mask{};
+        for (std::size_t index = 0; index < kCells; ++index) {
+            if (index == Geometry::kCenter) {
+                continue;
+            }
+            if (!draw(m_cards[index])) {
+                return false;
+            }
+            m_occupied = m_occupied | Ops::bit(index);
+        }
+        return true;
+    }
+
+    CardId cardAt(std::size_t index) const { return m_cards[index]; }
+    bool isOccupiedAt(std::size_t index) const { return Ops::test(m_occupied, index); }
+    bool isFaceUpAt(std::size_t index) const { return Ops::test(m_faceUp, index); }
+    bool isBlockedAt(std::size_t index) const { return Ops::test(m_blocked, index); }
+    void turnFaceUpAt(std::size_t index) { m_faceUp = m_faceUp | Ops::bit(index); }
+    void turnFaceDownAt(std::size_t index) { m_faceUp = m_faceUp & ~Ops::bit(index); }
+    // Parameters: index, card (CardId). Stores the card without changing any mask.
+    void setCardAt(std::size_t index, CardId card) { m_cards[index] = card; }
+    // Parameters: index, card (CardId). Stores the card and marks the cell occupied.
+    void placeAt(std::size_t index, CardId card) {
+        m_cards[index] = card;
+        m_occupied = m_occupied | Ops::bit(index);
+    }
+    void setBlockedAt(std::size_t index, bool blocked) {
+        m_blocked = blocked ? m_blocked | Ops::bit(index) : m_blocked & ~Ops::bit(index);
+    }
+    // Parameters: index (std::size_t). Leaves that cell as the only blocked one.
+    void blockOnlyAt(std::size_t index) { m_blocked = Ops::bit(index); }
+    void clearBlocked() { m_blocked = Mask{}; }
+    // No parameters. Turns every card face down and clears the block.
+    void allFacesDown() {
+        m_faceUp = Mask{};
+        m_blocked = Mask{};
+    }
+
+    // Parameters: first/second (std::size_t). Swaps cards and all per-cell flags of two cells.
+    void swapCellsAt(std::size_t first, std::size_t second) {
+        std::swap(m_cards[first], m_cards[second]);
+        const Mask both = Ops::bit(first) | Ops::bit(second);
+        // Exchange the two bits of every mask (no-op for masks where they are equal).
+        auto swapBits = [first, second, &both](Mask& mask) {
+            if (Ops::test(mask, first) != Ops::test(mask, second)) {
+                mask = mask ^ both;
+            }
+        };
+        swapBits(m_occupied);
+        swapBits(m_faceUp);
+        swapBits(m_blocked);
+    }
+
+    // Parameters: cards (card ids per cell), faceUp/blocked (cell masks). Replaces the layout of an
+    // already dealt grid; flags outside occupied cells are dropped.
+    void restore(const std::array<CardId, kCells>& cards, const Mask& faceUp, const Mask& blocked) {
+        m_cards = cards;
+        m_faceUp = faceUp & m_occupied;
+        m_blocked = blocked & m_occupied;
+    }
+
+    const std::array<CardId, kCells>& cards() const { return m_cards; }
+    Mask occupiedMask() const { return m_occupied; }
+    Mask faceUpMask() const { return m_faceUp; }
+    Mask blockedMask() const { return m_blocked; }
+    Mask faceDownMask() const { return m_occupied & ~m_faceUp; }
+    // Parameters: blockActive (bool). Returns face-down cells, minus the blocked one when blockActive.
+    Mask flippableMask(bool blockActive) const {
+        return faceDownMask() & ~(blockActive ? m_blocked : Mask{});
+    }
+
+private:
+    std::array<CardId, kCells> m_cards{};
+    Mask m_occupied{};
+    Mask m_faceUp{};
+    Mask m_blocked{};
+};
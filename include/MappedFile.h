@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Read-only view of a whole file. Uses mmap on POSIX systems so that large logs are paged in
+// on demand; elsewhere the file is read into memory once.
+class MappedFile {
+public:
+    // Parameters: path (const std::string&). Throws std::runtime_error if the file cannot be opened.
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // No parameters. Returns the first byte of the file (nullptr for an empty file).
+    const std::uint8_t* data() const;
+    // No parameters. Returns the file size in bytes.
+    std::size_t size() const;
+
+private:
+    const std::uint8_t* m_data{nullptr};
+    std::size_t m_size{0};
+    bool m_mapped{false};
+    std::vector<std::uint8_t> m_buffer;
+};
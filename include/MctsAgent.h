@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Agent.h"
+#include "GameObserver.h"
+#include "MemoryAgent.h"
+#include "Random.h"
+#include "ThreadPool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Search budget and tuning for MctsAgent. The search stops at whichever budget runs out first.
+struct MctsConfig {
+    // Total iterations per decision, split across threads; 0 means no iteration limit.
+    std::size_t iterations{4000};
+    // Wall-clock budget per decision in seconds; 0 means no time limit.
+    double seconds{0.0};
+    // Independent search trees run in parallel; their root visit counts are summed.
+    std::size_t threads{1};
+    // UCB1 exploration constant.
+    double exploration{0.7};
+};
+
+// Bot that runs information-set Monte Carlo tree search for every decision (flip, octopus swap,
+// penguin flip-down, walrus block). Each iteration deals the cards it has not seen onto the unknown
+// cells at random, then searches the rest of the round; the reward is winning the round.
+// Register it as an Engine observer too: it tracks remembered cards and pending turtle/walrus effects.
+class MctsAgent : public Agent, public GameObserver {
+public:
+    // Parameters: seed (std::uint64_t), config (MctsConfig). With an iteration-only budget the
+    // choices are reproducible from the seed and thread count (each thread grows its own tree).
+    explicit MctsAgent(std::uint64_t seed, const MctsConfig& config = MctsConfig());
+    ~MctsAgent() override;
+
+    void peek(const Game& game, const Player& player, std::uint32_t cells) override;
+    Position chooseFlip(const Game& game, const Player& player, bool blockActive) override;
+    Position chooseOctopusTarget(const Game& game, const Player& player, const Position& origin,
+                                 const std::vector<Position>& options) override;
+    bool choosePenguinTarget(const Game& game, const Player& player, const std::vector<Position>& options,
+                             Position& target) override;
+    bool chooseWalrusBlock(const Game& game, const Player& player, Position& target) override;
+
+    void onEvent(const Game& game, const GameEvent& event) override;
+
+private:
+    struct SearchState;
+
+    // Parameters: game, player, phase-specific setup. Returns the root state for a decision.
+    SearchState rootState(const Game& game, const Player& player) const;
+    // Parameters: root (const SearchState&). Returns the most visited root action.
+    std::uint16_t search(const SearchState& root);
+
+    BoardKnowledge m_knowledge;
+    MctsConfig m_config;
+    Xoshiro256 m_rng;
+    int m_skipCount{0};
+    bool m_walrusPending{false};
+    std::unique_ptr<WorkStealingPool> m_pool;
+};
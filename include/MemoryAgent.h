@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Agent.h"
+#include "Board.h"
+#include "GameObserver.h"
+#include "Random.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Compact per-player memory of a Geometry board: which cells have been seen and the card that was
+// there, following the engine's public events. BoardKnowledge is the classic instance.
+template <class Geometry>
+struct GridKnowledge {
+    using Mask = typename Geometry::Mask;
+    using Ops = MaskOps<Mask>;
+
+    Mask known{};
+    std::array<CardId, Geometry::kCells> cards{};
+
+    // Parameters: index (std::size_t), card (CardId). Records the card seen at a cell.
+    void learn(std::size_t index, CardId card) {
+        known = known | Ops::bit(index);
+        cards[index] = card;
+    }
+    // Parameters: first/second (std::size_t). Mirrors GridBoard::swapCellsAt.
+    void swap(std::size_t first, std::size_t second) {
+        if (Ops::test(known, first) != Ops::test(known, second)) {
+            known = known ^ (Ops::bit(first) | Ops::bit(second));
+        }
+        const CardId card = cards[first];
+        cards[first] = cards[second];
+        cards[second] = card;
+    }
+    // Parameters: game (const BasicGame<Geometry>&), event (const GameEvent&). Applies a public engine event:
+    // forgets everything at GameStart, learns revealed cards and follows octopus swaps.
+    void observe(const BasicGame<Geometry>& game, const GameEvent& event);
+};
+
+using BoardKnowledge = GridKnowledge<ClassicGeometry>;
+
+// Bot that remembers every card it has peeked at or seen revealed, including where octopus swaps
+// moved them, and flips known matches whenever it can. Register it as an observer of the engine
+// as well as the seat's agent so that it sees every flip and swap. MemoryAgent plays the classic board.
+template <class Geometry>
+class BasicMemoryAgent : public BasicAgent<Geometry>, public BasicGameObserver<Geometry> {
+public:
+    using Mask = typename Geometry::Mask;
+
+    // Parameters: seed (std::uint64_t). Seeds tie-breaking among unknown cards.
+    explicit BasicMemoryAgent(std::uint64_t seed);
+
+    void peek(const BasicGame<Geometry>& game, const Player& player, Mask cells) override;
+    Position chooseFlip(const BasicGame<Geometry>& game, const Player& player, bool blockActive) override;
+    Position chooseOctopusTarget(const BasicGame<Geometry>& game, const Player& player, const Position& origin,
+                                 const std::vector<Position>& options) override;
+    bool choosePenguinTarget(const BasicGame<Geometry>& game, const Player& player,
+                             const std::vector<Position>& options, Position& target) override;
+    bool chooseWalrusBlock(const BasicGame<Geometry>& game, const Player& player, Position& target) override;
+
+    void onEvent(const BasicGame<Geometry>& game, const GameEvent& event) override;
+
+    // No parameters. Returns the current memory (for diagnostics and search agents).
+    const GridKnowledge<Geometry>& knowledge() const;
+
+private:
+    // Parameters: game (const BasicGame<Geometry>&), candidates (cell mask). Returns known cells in
+    // candidates whose card matches the game's current card (all known candidates when no card is showing).
+    Mask knownMatches(const BasicGame<Geometry>& game, const Mask& candidates) const;
+    // Parameters: mask (cell mask, non-empty). Returns a uniformly chosen cell index from mask.
+    std::size_t pick(const Mask& mask);
+
+    GridKnowledge<Geometry> m_knowledge;
+    Xoshiro256 m_rng;
+};
+
+using MemoryAgent = BasicMemoryAgent<ClassicGeometry>;
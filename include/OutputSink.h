@@ -0,0 +1,84 @@
+#pragma once
+
+#include "GameObserver.h"
+#include "Renderer.h"
+#include "Replay.h"
+
+#include <array>
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+class Player;
+
+// Amount of game output, each level including the ones before it: nothing, final results,
+// round headers / ruby awards / standings, every turn message, and the board after every flip
+// (the interactive transcript).
+enum class Verbosity { Silent, Results, Rounds, Turns, Boards };
+
+// Parameters: text (const std::string&), verbosity (Verbosity&) output. Returns true for
+// "silent", "results", "rounds", "turns" or "boards".
+bool parse_verbosity(const std::string& text, Verbosity& verbosity);
+
+// Writes the human-readable messages for engine events up to a verbosity level. Each event is
+// formatted into a fixed buffer and handed to the stream with one write and no flush, so output
+// costs one call per message instead of a flush per line; the stream is flushed at GameEnd.
+class ConsoleSink : public GameObserver {
+public:
+    // Parameters: os (std::ostream&), verbosity (Verbosity). os must outlive the sink.
+    ConsoleSink(std::ostream& os, Verbosity verbosity);
+
+    // Parameters: verbosity (Verbosity). Takes effect from the next event.
+    void setVerbosity(Verbosity verbosity) { m_verbosity = verbosity; }
+    Verbosity verbosity() const { return m_verbosity; }
+
+    void onEvent(const Game& game, const GameEvent& event) override;
+
+private:
+    void appendPosition(const Position& position);
+    void appendRubies(int rubies);
+    void appendStandings(const std::vector<Player>& players);
+    void appendWinners(const std::vector<Player>& players);
+
+    std::ostream& m_os;
+    Verbosity m_verbosity;
+    FrameWriter m_frame;
+    // Reused by appendStandings so that sorting never allocates after the first round.
+    std::vector<const Player*> m_order;
+};
+
+// Discards every event; the sink for headless runs, so no message is ever formatted.
+class SilentSink : public GameObserver {
+public:
+    void onEvent(const Game&, const GameEvent&) override {}
+};
+
+// Writes every event as a packed ReplayRecord (see Replay.h; decode with to_event), with no file
+// or game header. Records are collected in a fixed buffer and written in large chunks.
+class BinarySink : public GameObserver {
+public:
+    static constexpr std::size_t kBufferedRecords = 4096;
+
+    // Parameters: os (std::ostream&) opened in binary mode; must outlive the sink.
+    explicit BinarySink(std::ostream& os);
+    // Writes any buffered records.
+    ~BinarySink() override;
+
+    BinarySink(const BinarySink&) = delete;
+    BinarySink& operator=(const BinarySink&) = delete;
+
+    void onEvent(const Game& game, const GameEvent& event) override;
+    // No parameters. Writes buffered records to the stream.
+    void flush();
+
+private:
+    std::ostream& m_os;
+    std::size_t m_count{0};
+    std::array<ReplayRecord, kBufferedRecords> m_records;
+};
+
+// Parameters: os (std::ostream&), verbosity (Verbosity). Returns a SilentSink for
+// Verbosity::Silent, otherwise a ConsoleSink writing to os.
+std::unique_ptr<GameObserver> make_console_sink(std::ostream& os, Verbosity verbosity);
@@ -21,8 +21,12 @@ public:
     int getNRubies() const;
     // Parameters: rubis (const Rubis&). Adds 1-4 to the player score.
     void addRubis(const Rubis& rubis);
+    // Parameters: rubies (int). Overwrites the score (used when restoring a snapshot).
+    void setNRubies(int rubies);
     // Parameters: endOfGame (bool). Toggles whether printing shows seat info or rubies.
     void setDisplayMode(bool endOfGame);
+    // No parameters. Returns true when printing shows rubies instead of seat info.
+    bool displaysRubies() const;
     // No parameters. Returns the side (top/bottom/left/right) assigned to this player.
     Side getSide() const;
     // Parameters: side (Side). Updates which side this player represents on the board.
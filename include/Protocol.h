@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Card.h"
+#include "Engine.h"
+#include "Enums.h"
+#include "GameObserver.h"
+
+#include <string>
+
+// Compact text encoding of positions, cards, events and input requests for machine clients
+// (the table server and the line protocol). Every message is one '\n'-terminated line of
+// space-separated tokens; positions are "B3", cards are animal + background symbols ("Or").
+
+// Parameters: out (std::string&), position (const Position&). Appends e.g. "B3".
+void append_position(std::string& out, const Position& position);
+// Parameters: out (std::string&), card (const Card&). Appends its two symbols, e.g. "Or".
+void append_card(std::string& out, const Card& card);
+
+// Parameters: type (EventType). Returns the lowercase protocol name, e.g. "octopus-swap".
+const char* event_name(EventType type);
+// Parameters: kind (InputKind). Returns "flip", "octopus", "penguin", "block" (or "none").
+const char* input_name(InputKind kind);
+
+// Parameters: out (std::string&), game (const Game&), event (const GameEvent&). Appends
+// "event <name> [seat=N] [pos=B3] [target=C2] [card=Or] [value=N]\n" with only the fields that apply;
+// card is the revealed card of a flip.
+void append_event(std::string& out, const Game& game, const GameEvent& event);
+// Parameters: out (std::string&), game (const Game&), request (const InputRequest&). Appends
+// "await <kind> seat=N [origin=B3] options=A1,A2,...\n"; for flips and blocks the options are the
+// cards that may legally be chosen.
+void append_request(std::string& out, const Game& game, const InputRequest& request);
+// Parameters: out (std::string&), game (const Game&), seat (std::size_t). Appends
+// "peek A2=Cr A3=Pg A4=Wy\n" with the cards the seat may look at during the peek phase.
+void append_peek(std::string& out, const Game& game, std::size_t seat);
+// Parameters: out (std::string&), game (const Game&), engine (const Engine&). Appends one line:
+// "state round=R turn=N await=<kind> active=1011 rubies=0,2,0,1 current=Or previous=- blocked=-
+// up=A1=Cr,B2=Pg". Only public information is included (face-up cards, never face-down ones).
+void append_state(std::string& out, const Game& game, const Engine& engine);
+// Parameters: out (std::string&), game (const Game&). Appends "board\n", the console rendering
+// with every line prefixed by "| ", and "end\n".
+void append_frame(std::string& out, const Game& game);
+
+// Result of applying a move command to an engine.
+enum class MoveStatus { Accepted, Illegal, NotExpected, BadArgument };
+
+// Parameters: command (const std::string&). Returns true for "flip", "octopus", "penguin", "block".
+bool is_move_command(const std::string& command);
+// Parameters: engine (Engine&), command (const std::string&), argument (const std::string&) a position
+// or "skip" (penguin and block only). Submits the move for the pending request; call
+// engine.advance() after MoveStatus::Accepted.
+MoveStatus submit_move(Engine& engine, const std::string& command, const std::string& argument);
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CardDeck.h"
+#include "Engine.h"
+#include "GameObserver.h"
+#include "MemoryAgent.h"
+#include "RubisDeck.h"
+#include "Rules.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class ReplayRecorder;
+class ReplayWriter;
+
+// Non-interactive driver for `memoarrr --protocol`: a controlling program (external bot, test
+// harness) sends one command per line and receives compact lines built with Protocol.h.
+// Seats without a bot are answered through the move commands; the engine only stops at their
+// decisions, so a command costs one parse, the engine work and the appended reply.
+class ProtocolSession : public GameObserver {
+public:
+    // Parameters: replay (ReplayWriter*) optional log that receives every finished game.
+    explicit ProtocolSession(ReplayWriter* replay = nullptr);
+    ~ProtocolSession() override;
+
+    // Parameters: line (const std::string&) one command, out (std::string&) receives the reply lines.
+    // Returns false once "quit" has been handled.
+    bool handle(const std::string& line, std::string& out);
+
+    void onEvent(const Game& game, const GameEvent& event) override;
+
+private:
+    void newGame(const std::vector<std::string>& tokens, std::string& out);
+    void move(const std::vector<std::string>& tokens, std::string& out);
+    void resume(std::string& out);
+
+    ReplayWriter* m_replay;
+    CardDeck m_cardDeck;
+    RubisDeck m_rubisDeck;
+    Rules m_rules;
+    std::unique_ptr<Game> m_game;
+    std::unique_ptr<Engine> m_engine;
+    std::unique_ptr<ReplayRecorder> m_recorder;
+    std::vector<std::unique_ptr<MemoryAgent>> m_bots;
+    std::vector<std::string> m_tokens;
+    // Seats from here on are MemoryAgents; the others are answered by the controlling program.
+    std::size_t m_firstBot{0};
+    // Reply being built while the engine runs; events are appended to it.
+    std::string* m_out{nullptr};
+    bool m_events{true};
+};
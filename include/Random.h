@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+// Parameters: state (std::uint64_t&) advanced in place. Returns the next SplitMix64 output.
+// Used to expand a single seed into generator state and to derive independent per-game seeds.
+inline std::uint64_t splitmix64(std::uint64_t& state) {
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// xoshiro256** generator: 32 bytes of state, a few cycles per draw, period 2^256 - 1.
+// Satisfies UniformRandomBitGenerator. Each instance is owned by one deck/agent, so no locking.
+class Xoshiro256 {
+public:
+    using result_type = std::uint64_t;
+
+    // Parameters: seed (std::uint64_t). Any value (including 0) yields a valid non-zero state.
+    explicit Xoshiro256(std::uint64_t seed = 0x4D656D6F61727272ULL) {
+        reseed(seed);
+    }
+
+    // Parameters: seed (std::uint64_t). Resets the state as if freshly constructed with seed.
+    void reseed(std::uint64_t seed) {
+        for (auto& word : m_state) {
+            word = splitmix64(seed);
+        }
+    }
+
+    static constexpr result_type min() {
+        return 0;
+    }
+    static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    // No parameters. Returns the next 64 random bits.
+    result_type operator()() {
+        const std::uint64_t result = rotl(m_state[1] * 5, 7) * 9;
+        const std::uint64_t t = m_state[1] << 17;
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = rotl(m_state[3], 45);
+        return result;
+    }
+
+    // Parameters: range (std::uint32_t, > 0). Returns an unbiased value in [0, range) (Lemire's method).
+    std::uint32_t bounded(std::uint32_t range) {
+        std::uint64_t product = static_cast<std::uint64_t>(static_cast<std::uint32_t>((*this)() >> 32)) * range;
+        std::uint32_t low = static_cast<std::uint32_t>(product);
+        if (low < range) {
+            const std::uint32_t threshold = (0u - range) % range;
+            while (low < threshold) {
+                product = static_cast<std::uint64_t>(static_cast<std::uint32_t>((*this)() >> 32)) * range;
+                low = static_cast<std::uint32_t>(product);
+            }
+        }
+        return static_cast<std::uint32_t>(product >> 32);
+    }
+
+    // No parameters. Advances the state by 2^128 draws (equivalent to that many operator() calls).
+    void jump() {
+        static constexpr std::uint64_t kJump[] = {0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL,
+                                                  0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL};
+        applyJump(kJump);
+    }
+
+    // No parameters. Advances the state by 2^192 draws; separates groups of jump() streams.
+    void longJump() {
+        static constexpr std::uint64_t kLongJump[] = {0x76E15D3EFEFDCBBFULL, 0xC5004E441C522FB3ULL,
+                                                      0x77710069854EE241ULL, 0x39109BB02ACBE635ULL};
+        applyJump(kLongJump);
+    }
+
+    // No parameters. Returns a generator positioned at the current state and jumps this one ahead,
+    // so the two produce non-overlapping streams of 2^128 draws.
+    Xoshiro256 split() {
+        Xoshiro256 stream(*this);
+        jump();
+        return stream;
+    }
+
+    bool operator==(const Xoshiro256& other) const {
+        return m_state[0] == other.m_state[0] && m_state[1] == other.m_state[1] &&
+               m_state[2] == other.m_state[2] && m_state[3] == other.m_state[3];
+    }
+    bool operator!=(const Xoshiro256& other) const {
+        return !(*this == other);
+    }
+
+private:
+    static std::uint64_t rotl(std::uint64_t value, int shift) {
+        return (value << shift) | (value >> (64 - shift));
+    }
+
+    void applyJump(const std::uint64_t (&table)[4]) {
+        std::uint64_t s0 = 0;
+        std::uint64_t s1 = 0;
+        std::uint64_t s2 = 0;
+        std::uint64_t s3 = 0;
+        for (std::uint64_t word : table) {
+            for (int bit = 0; bit < 64; ++bit) {
+                if (word & (std::uint64_t{1} << bit)) {
+                    s0 ^= m_state[0];
+                    s1 ^= m_state[1];
+                    s2 ^= m_state[2];
+                    s3 ^= m_state[3];
+                }
+                (*this)();
+            }
+        }
+        m_state[0] = s0;
+        m_state[1] = s1;
+        m_state[2] = s2;
+        m_state[3] = s3;
+    }
+
+    std::uint64_t m_state[4];
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Agent.h"
+#include "Random.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Parameters: mask (non-empty cell mask), rng (Xoshiro256&). Returns a uniformly chosen cell of the mask
+// (one bounded draw, so every bot consumes its generator the same way on every geometry).
+template <typename Mask>
+std::size_t random_cell(const Mask& mask, Xoshiro256& rng) {
+    return nth_cell(mask, rng.bounded(MaskOps<Mask>::count(mask)));
+}
+
+// Headless agent that picks uniformly among legal choices; used for simulations and filling seats.
+// RandomAgent plays the classic board.
+template <class Geometry>
+class BasicRandomAgent : public BasicAgent<Geometry> {
+public:
+    // Parameters: seed (std::uint32_t). Seeds the agent's private generator.
+    explicit BasicRandomAgent(std::uint32_t seed);
+
+    Position chooseFlip(const BasicGame<Geometry>& game, const Player& player, bool blockActive) override;
+    Position chooseOctopusTarget(const BasicGame<Geometry>& game, const Player& player, const Position& origin,
+                                 const std::vector<Position>& options) override;
+    bool choosePenguinTarget(const BasicGame<Geometry>& game, const Player& player,
+                             const std::vector<Position>& options, Position& target) override;
+    bool chooseWalrusBlock(const BasicGame<Geometry>& game, const Player& player, Position& target) override;
+
+private:
+    // Parameters: game (const BasicGame<Geometry>&), blockActive (bool). Returns a random face-down
+    // (unblocked) position.
+    Position randomFaceDown(const BasicGame<Geometry>& game, bool blockActive);
+
+    Xoshiro256 m_rng;
+};
+
+using RandomAgent = BasicRandomAgent<ClassicGeometry>;
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Card.h"
+#include "Game.h"
+
+#include <array>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+// Builds whole frames (board grid, expert row, player summaries) in a fixed buffer using
+// precomputed card glyphs, then emits them with a single ostream::write. Never allocates.
+class FrameWriter {
+public:
+    // Large enough for a base frame with four players; longer output is flushed in chunks.
+    static constexpr std::size_t kCapacity = 2048;
+
+    // Parameters: os (std::ostream&) destination for flushed frames.
+    explicit FrameWriter(std::ostream& os);
+    // Flushes anything still buffered.
+    ~FrameWriter();
+
+    FrameWriter(const FrameWriter&) = delete;
+    FrameWriter& operator=(const FrameWriter&) = delete;
+
+    // Parameters: board (const Board&). Appends the 5x5 grid with row letters and column numbers.
+    void appendBoard(const Board& board);
+    // Parameters: board (const Board&). Appends the expert row of face-up cards with their labels.
+    void appendExpertRow(const Board& board);
+    // Parameters: player (const Player&). Appends one player summary line (same text as operator<<).
+    void appendPlayer(const Player& player);
+    // Parameters: game (const Game&). Appends the board in the game's display mode plus all players.
+    void appendGame(const Game& game);
+    // Parameters: text (const char*). Appends the NUL-terminated text verbatim.
+    void appendText(const char* text);
+    // Parameters: text (const std::string&). Appends the text verbatim.
+    void appendText(const std::string& text);
+    // Parameters: value (int). Appends its decimal digits.
+    void appendNumber(int value);
+
+    // No parameters. Writes buffered bytes to the stream in one call and empties the buffer.
+    void flush();
+
+    // No parameters. Buffered frame contents, for callers that forward frames themselves.
+    const char* data() const;
+    std::size_t size() const;
+    // No parameters. Discards buffered bytes without writing them.
+    void clear();
+
+private:
+    void put(char c);
+    void put(const char* text, std::size_t length);
+    void putText(const char* text);
+    void putInt(int value);
+    void putGlyphRow(CardId card, std::size_t row);
+
+    std::ostream& m_os;
+    std::size_t m_size{0};
+    std::array<char, kCapacity> m_buffer;
+};
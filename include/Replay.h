@@ -0,0 +1,128 @@
+#pragma once
+
+#include "Agent.h"
+#include "Engine.h"
+#include "GameObserver.h"
+#include "Snapshot.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Log layout: a ReplayFileHeader, then one block per game: a ReplayGameHeader followed by
+// recordCount ReplayRecords, one per engine event in emission order. All integers are native
+// byte order; records are byte arrays, so blocks need no alignment.
+struct ReplayFileHeader {
+    static constexpr std::uint32_t kMagic = 0x4C50524Du; // "MRPL"
+    static constexpr std::uint32_t kVersion = 2;
+
+    std::uint32_t magic{kMagic};
+    std::uint32_t version{kVersion};
+};
+
+// Start of one recorded game: its seed, rules variant and the state right after the deal.
+struct ReplayGameHeader {
+    static constexpr std::uint32_t kMagic = 0x454D4147u; // "GAME"
+
+    std::uint32_t magic{kMagic};
+    std::uint32_t recordCount{0};
+    std::uint64_t seed{0};
+    std::uint8_t rulesMode{0};
+    std::uint8_t reserved[7]{};
+    GameSnapshot start;
+};
+
+// One GameEvent: positions are cell indices (row * 5 + column), value is the ruby amount or round.
+struct ReplayRecord {
+    std::uint8_t type;
+    std::uint8_t player;
+    std::uint8_t position;
+    std::uint8_t target;
+    std::uint8_t value;
+};
+
+// Parameters: event (const GameEvent&). Returns its compact record.
+ReplayRecord to_record(const GameEvent& event);
+// Parameters: record (const ReplayRecord&). Returns the event, throws std::runtime_error if corrupt.
+GameEvent to_event(const ReplayRecord& record);
+
+// Raised when a replayed game stops following its log (an engine change or a corrupt record).
+class ReplayDivergence : public std::runtime_error {
+public:
+    explicit ReplayDivergence(const std::string& msg) : std::runtime_error(msg) {}
+};
+
+// Append-only replay file shared by any number of recorders. Whole games are appended under a
+// lock, so concurrent simulations never interleave their blocks.
+class ReplayWriter {
+public:
+    // Parameters: path (const std::string&). Opens for append and writes the file header if the file is new.
+    explicit ReplayWriter(const std::string& path);
+
+    // Parameters: block (const std::vector<std::uint8_t>&) one complete game block.
+    void append(const std::vector<std::uint8_t>& block);
+    // No parameters. Pushes buffered blocks to the file.
+    void flush();
+
+private:
+    std::mutex m_mutex;
+    std::ofstream m_out;
+};
+
+// Records one game: captures the engine snapshot at GameStart, buffers every event and appends
+// the finished block to the writer at GameEnd.
+class ReplayRecorder : public GameObserver {
+public:
+    // Parameters: writer (ReplayWriter&), engine (const Engine&), seed (std::uint64_t) stored with the game.
+    ReplayRecorder(ReplayWriter& writer, const Engine& engine, std::uint64_t seed);
+
+    void onEvent(const Game& game, const GameEvent& event) override;
+
+private:
+    ReplayWriter& m_writer;
+    const Engine& m_engine;
+    ReplayGameHeader m_header;
+    std::vector<std::uint8_t> m_block;
+};
+
+// Agent that answers every decision from a recorded game, in log order.
+class ReplayAgent : public Agent {
+public:
+    // Parameters: records/count (the game's records). Both must outlive the agent.
+    ReplayAgent(const ReplayRecord* records, std::size_t count);
+
+    Position chooseFlip(const Game& game, const Player& player, bool blockActive) override;
+    Position chooseOctopusTarget(const Game& game, const Player& player, const Position& origin,
+                                 const std::vector<Position>& options) override;
+    bool choosePenguinTarget(const Game& game, const Player& player, const std::vector<Position>& options,
+                             Position& target) override;
+    bool chooseWalrusBlock(const Game& game, const Player& player, Position& target) override;
+
+private:
+    // Parameters: expected/alternative (EventType). Returns the next decision record, which must
+    // have one of the two types; throws ReplayDivergence otherwise.
+    const ReplayRecord& nextDecision(EventType expected, EventType alternative);
+
+    const ReplayRecord* m_records;
+    std::size_t m_count;
+    std::size_t m_cursor{0};
+};
+
+// Outcome of replaying a log.
+struct ReplayReport {
+    std::size_t games{0};
+    std::size_t events{0};
+    // Games whose re-executed events differ from the log, with the seed of the first one.
+    std::size_t divergent{0};
+    std::uint64_t firstDivergentSeed{0};
+    std::string firstDivergence;
+};
+
+// Parameters: path (const std::string&), threads (std::size_t, 0 = hardware threads). Memory-maps
+// the log, re-executes every game through the Engine with ReplayAgents, and checks each emitted
+// event against the record. Throws std::runtime_error if the file is not a replay log.
+ReplayReport replay_log(const std::string& path, std::size_t threads = 0);
@@ -3,17 +3,26 @@
 #include "DeckFactory.h"
 #include "Rubis.h"
 
-// Singleton deck factory for distributing random ruby rewards after each round.
-class RubisDeck : public DeckFactory<Rubis> {
+struct GameSnapshot;
+
+// Deck factory for distributing random ruby rewards after each round.
+class RubisDeck : public DeckFactory<Rubis, 7> {
 public:
-    // Provides the single RubisDeck instance for the duration of the program.
+    // No parameters. Builds an independent deck with the standard ruby distribution.
+    RubisDeck();
+
+    // Provides the shared RubisDeck instance used by the interactive game.
     static RubisDeck& make_RubisDeck();
 
-    // Rebuilds the deck with the assignment-specified ruby distribution.
+    // Returns every ruby card to the deck in its initial order (no allocation).
     void reset();
 
+    // Parameters: snapshot (GameSnapshot&). Stores the remaining rubies in draw order and the generator.
+    void saveState(GameSnapshot& snapshot) const;
+    // Parameters: snapshot (const GameSnapshot&). Rebuilds the deck exactly as saveState found it.
+    void restoreState(const GameSnapshot& snapshot);
+
 private:
-    RubisDeck();
     // Pushes the configured counts of 1-4 ruby rewards onto the deck storage.
     void build();
 };
@@ -2,20 +2,28 @@
 
 #include "Game.h"
 
-// Implements the core rule checks (matching logic, round/game termination, turn order).
+// Implements the core rule checks (matching logic, round/game termination, turn order) for a game on
+// any board geometry. Base versus expert play is a compile-time policy of the engine (RulesPolicy.h),
+// not a Rules setting.
 class Rules {
 public:
-    explicit Rules(bool expertRules);
+    // Rounds in one game.
+    static constexpr int kRounds = 7;
 
-    // Parameters: game (const Game&). Returns true when current card matches previous.
-    bool isValid(const Game& game) const;
-    // Parameters: game (const Game&). Returns true after seven rounds are complete.
-    bool gameOver(const Game& game) const;
-    // Parameters: game (const Game&). Returns true if <= 1 active players remain.
-    bool roundOver(const Game& game) const;
-    // Parameters: game (const Game&). Returns reference to next active player.
-    const Player& getNextPlayer(const Game& game) const;
-
-private:
-    bool m_useExpertRules{false};
+    // Parameters: game (const BasicGame<Geometry>&). Returns true when current card matches previous.
+    template <class Geometry>
+    bool isValid(const BasicGame<Geometry>& game) const;
+    // Parameters: previous/current (const BasicCard<Geometry>&). Returns true when they share an animal or
+    // a background.
+    template <class Geometry>
+    static bool matches(const BasicCard<Geometry>& previous, const BasicCard<Geometry>& current);
+    // Parameters: game (const BasicGame<Geometry>&). Returns true after kRounds rounds are complete.
+    template <class Geometry>
+    bool gameOver(const BasicGame<Geometry>& game) const;
+    // Parameters: game (const BasicGame<Geometry>&). Returns true if <= 1 active players remain.
+    template <class Geometry>
+    bool roundOver(const BasicGame<Geometry>& game) const;
+    // Parameters: game (const BasicGame<Geometry>&). Returns reference to next active player.
+    template <class Geometry>
+    const Player& getNextPlayer(const BasicGame<Geometry>& game) const;
 };
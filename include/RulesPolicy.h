@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Card.h"
+#include "Enums.h"
+#include "Rules.h"
+
+// Compile-time rules policies for the Engine turn loop (see BasicEngine). A policy is a type with
+//   static constexpr RulesMode kMode;                      the mode it implements
+//   static constexpr bool ability(FaceAnimal animal);      whether that animal's expert effect applies
+//   template <class Geometry>
+//   static bool matches(const BasicCard<Geometry>& previous, const BasicCard<Geometry>& current);
+// Every member is resolved at compile time, so disabled abilities leave no code in the turn loop. A
+// policy serves every board geometry; animals past Walrus on larger alphabets never have an ability.
+// Variants derive from one of the policies below and shadow what they change, e.g.
+//   struct NoTurtleRules : ExpertRules {
+//       static constexpr bool ability(FaceAnimal animal) { return animal != FaceAnimal::Turtle; }
+//   };
+
+// Base game: matches only, no animal abilities.
+struct BaseRules {
+    static constexpr RulesMode kMode = RulesMode::Base;
+
+    static constexpr bool ability(FaceAnimal) { return false; }
+
+    template <class Geometry>
+    static bool matches(const BasicCard<Geometry>& previous, const BasicCard<Geometry>& current) {
+        return Rules::matches(previous, current);
+    }
+};
+
+// Expert rules: every animal applies its ability after a matching flip.
+struct ExpertRules : BaseRules {
+    static constexpr RulesMode kMode = RulesMode::Expert;
+
+    static constexpr bool ability(FaceAnimal) { return true; }
+};
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "Agent.h"
+#include "GameObserver.h"
+#include "MappedFile.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class ReplayWriter;
+
+// Match scripts drive `memoarrr --script=<file>`: the setup answers and every move of any number
+// of games, read from a memory-mapped text file instead of prompts. One command per line, tokens
+// separated by spaces, '#' starts a comment line:
+//
+//   game seed=42 rules=expert display=base bots=1
+//   player Alice top
+//   player Bob right
+//   flip B3
+//   octopus C3
+//   penguin skip
+//   block A1
+//
+// "game" starts a match (all keys optional; seed defaults to 0, both modes to base, bots to 0),
+// "player" seats a scripted human (2-4 seats in total with the bots, which take the remaining
+// sides in top/right/bottom/left order). Larger tables (up to kMaxSeats) are seated around the
+// board in seat order as described in Seating.h, so their sides need not be distinct. Move lines answer the scripted seats' decisions in
+// order; penguin and block accept "skip". Decks and bot seeds come from the game seed exactly as
+// in `newgame seed=...` of the line protocol, so protocol sessions can be saved as scripts.
+
+// Script line that cannot be applied; what() names the line number.
+class ScriptError : public std::runtime_error {
+public:
+    explicit ScriptError(const std::string& msg) : std::runtime_error(msg) {}
+};
+
+// Token inside the mapped file (or any other caller-owned buffer); it never owns or copies the bytes.
+struct ScriptToken {
+    const char* begin{nullptr};
+    const char* end{nullptr};
+
+    // Parameters: text (const char*) NUL-terminated. Returns true when the token spells exactly text.
+    bool is(const char* text) const;
+    // Parameters: value (std::uint64_t&) output. Returns true when the token is a decimal number that
+    // fits 64 bits (nothing else may follow the digits).
+    bool toNumber(std::uint64_t& value) const;
+    // No parameters. Returns a copy of the token text (for messages).
+    std::string str() const;
+};
+
+// One non-blank line split in place.
+struct ScriptLine {
+    static constexpr std::size_t kMaxTokens = 8;
+
+    std::array<ScriptToken, kMaxTokens> tokens;
+    std::size_t count{0};
+    // 1-based line number in the file, for error messages.
+    std::size_t number{0};
+};
+
+// Parameters: begin/end (const char*) one line without its '\n', line (ScriptLine&) output. Records
+// the bounds of the tokens separated by spaces, tabs or '\r' (line.number is left alone); a line whose
+// first token starts with '#' is a comment and yields none. Returns false for more than
+// ScriptLine::kMaxTokens tokens.
+bool split_line(const char* begin, const char* end, ScriptLine& line);
+
+// Forward-only reader over a mapped script. Splitting a line only records token bounds, so
+// reading moves never allocates.
+class ScriptReader {
+public:
+    // Parameters: path (const std::string&). Throws std::runtime_error if the file cannot be opened.
+    explicit ScriptReader(const std::string& path);
+
+    // Parameters: line (ScriptLine&) output. Returns false at end of file; skips blank and comment
+    // lines. Throws ScriptError for a line with more than ScriptLine::kMaxTokens tokens.
+    bool next(ScriptLine& line);
+    // Parameters: line (const ScriptLine&). The next call to next() returns this line again.
+    void unread(const ScriptLine& line);
+
+private:
+    MappedFile m_file;
+    const char* m_cursor;
+    const char* m_end;
+    std::size_t m_lineNumber{0};
+    ScriptLine m_unread;
+    bool m_hasUnread{false};
+};
+
+// Agent answering the scripted seats of a game from the reader's next move lines. Every move is
+// checked against the request, so a bad script fails with the line at fault.
+class ScriptAgent : public Agent {
+public:
+    // Parameters: reader (ScriptReader&), must outlive the agent.
+    explicit ScriptAgent(ScriptReader& reader);
+
+    Position chooseFlip(const Game& game, const Player& player, bool blockActive) override;
+    Position chooseOctopusTarget(const Game& game, const Player& player, const Position& origin,
+                                 const std::vector<Position>& options) override;
+    bool choosePenguinTarget(const Game& game, const Player& player, const std::vector<Position>& options,
+                             Position& target) override;
+    bool chooseWalrusBlock(const Game& game, const Player& player, Position& target) override;
+
+    // No parameters. Returns the number of move lines consumed so far.
+    std::size_t moves() const { return m_moves; }
+
+private:
+    // Parameters: command (const char*), optional (bool) whether "skip" is allowed, target (Position&)
+    // output. Returns false for "skip"; throws ScriptError unless the next line is that command.
+    bool nextMove(const char* command, bool optional, Position& target);
+
+    ScriptReader& m_reader;
+    ScriptLine m_line;
+    std::size_t m_moves{0};
+};
+
+// Outcome of running a script.
+struct ScriptReport {
+    std::size_t games{0};
+    std::size_t moves{0};
+};
+
+// Parameters: path (const std::string&), out (std::ostream&) receives one
+// "game <n> seed=<s> rubies=a,b,..." line per finished game, replay (ReplayWriter*) optional log,
+// observers (extra sinks attached to every game, e.g. a ConsoleSink).
+// Plays every game of the script in order. Throws ScriptError for a malformed or illegal line.
+ScriptReport run_script(const std::string& path, std::ostream& out, ReplayWriter* replay = nullptr,
+                        const std::vector<GameObserver*>& observers = {});
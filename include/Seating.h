@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Enums.h"
+#include "Geometry.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+template <class Geometry>
+class BasicGame;
+
+// Seating model: which side of the board each seat of a table sits on and which cards it may look
+// at during the peek phase. Tables of up to kClassicSeats use the classic layout (one player per
+// side, peeking at the front of that edge). Larger tables are spread evenly clockwise around the
+// ring of edge cells starting at A1 (16 on the classic board, 24 on 7x7, 32 on 9x9); each seat
+// peeks at a window of that ring centred on its place, at most three cards wide and narrower as the
+// table grows, so on the classic board neighbours share a card from seventeen seats on. A large table
+// runs out of face-down cards long before every seat has flipped, so instead of reopening at seat 0
+// each round it carries the turn order over: the seat after the last one to flip opens the next round.
+
+// Most seats at one table (one bit per seat in Game's active mask).
+constexpr std::size_t kMaxSeats = 32;
+// Largest table that uses the classic layout.
+constexpr std::size_t kClassicSeats = 4;
+// Sides in the order tables are filled, matching the interactive side list (clockwise from the top).
+constexpr std::array<Side, kClassicSeats> kClassicSeatOrder{Side::Top, Side::Right, Side::Bottom, Side::Left};
+
+// Parameters: seat (std::size_t), seats (std::size_t) table size, 2..kMaxSeats. Returns the side a seat
+// is given when a table is filled in seat order: kClassicSeatOrder on classic tables, otherwise the
+// edge holding the centre of the seat's peek window on a Geometry board.
+template <class Geometry = ClassicGeometry>
+Side seat_side(std::size_t seat, std::size_t seats);
+// Parameters: seat (std::size_t), seats (std::size_t) table size, 2..kMaxSeats. Returns the cells of a
+// Geometry board the seat peeks at when the table is filled in seat order.
+template <class Geometry = ClassicGeometry>
+typename Geometry::Mask seat_peek_mask(std::size_t seat, std::size_t seats);
+// Parameters: game (const BasicGame<Geometry>&), seat (std::size_t). Returns the cells the seat peeks at
+// this round: the front of the player's own side on classic tables (where sides are chosen freely),
+// otherwise its window of the edge ring.
+template <class Geometry>
+typename Geometry::Mask peek_mask(const BasicGame<Geometry>& game, std::size_t seat);
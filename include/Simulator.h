@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Agent.h"
+#include "Enums.h"
+#include "Seating.h"
+#include "Statistics.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+class ReplayWriter;
+
+// Builds the agent for one seat of one simulated game from a per-seat seed.
+using AgentFactory = std::function<std::unique_ptr<Agent>(std::size_t seat, std::uint32_t seed)>;
+
+// Parameters for a batch of independent headless games.
+struct SimulationConfig {
+    std::size_t games{1000};
+    std::uint64_t seed{1};
+    std::size_t playerCount{4};
+    RulesMode rulesMode{RulesMode::Base};
+    // 0 selects one worker per hardware thread.
+    std::size_t threads{0};
+    // Empty selects RandomAgent for every seat.
+    AgentFactory agentFactory;
+    // When set, every game is appended to this replay log (in completion order); replays hold at most
+    // GameSnapshot::kMaxPlayers seats.
+    ReplayWriter* replay{nullptr};
+    // When set, run() also aggregates SimulationStats (see stats()).
+    bool collectStats{false};
+    // Board edge: 5 plays the classic game, 7 and 9 the same rules on Geometry7x7 / Geometry9x9 through
+    // the same engine (GameEngine); the larger boards record neither replays nor statistics.
+    std::size_t boardSize{5};
+    // 7x7 and 9x9 boards only (agentFactory builds classic agents): one letter per seat,
+    // r = BasicRandomAgent, m = BasicMemoryAgent; seats past the end are random.
+    std::string gridAgents;
+};
+
+// Outcome of one simulated game, stored at the game's index so results never depend on scheduling.
+struct GameResult {
+    std::uint64_t seed{0};
+    std::array<int, kMaxSeats> rubies{};
+    std::size_t flips{0};
+};
+
+// Runs many independent games in parallel. Each worker owns its decks; each game derives its
+// shuffles and agent seeds from (config.seed, game index) only, so results are bit-identical
+// for any thread count.
+class Simulator {
+public:
+    // Parameters: config (const SimulationConfig&). playerCount must be within 2-kMaxSeats
+    // (at most GameSnapshot::kMaxPlayers when recording a replay); 7x7 and 9x9 boards take no replay,
+    // statistics or agentFactory. Throws std::invalid_argument otherwise.
+    explicit Simulator(SimulationConfig config);
+
+    // No parameters. Plays config.games games and returns their results in game-index order.
+    std::vector<GameResult> run();
+
+    // Parameters: seed (std::uint64_t), index (std::uint64_t). Returns the seed used for game index.
+    static std::uint64_t gameSeed(std::uint64_t seed, std::uint64_t index);
+
+    // No parameters. Returns the statistics of the last run() (empty unless config.collectStats).
+    const SimulationStats& stats() const { return m_stats; }
+
+private:
+    SimulationConfig m_config;
+    SimulationStats m_stats;
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Card.h"
+#include "Random.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+// Fixed-size image of a match: board, turn cards, seats, the engine's turn position and pending
+// effects, and the ruby deck.
+// Trivially copyable, so saving and restoring is a handful of stores; the player roster (names)
+// and the card deck (unused once the board is dealt) are not part of it. It holds at most
+// kMaxPlayers seats, so the turn order that large tables carry between rounds is not stored and
+// tables of more than four seats cannot be saved.
+struct GameSnapshot {
+    static constexpr std::uint8_t kVersion = 2;
+    static constexpr std::size_t kMaxPlayers = 4;
+    static constexpr std::size_t kMaxRubies = 7;
+    // Number of engine turn phases; phase is below it.
+    static constexpr std::uint8_t kPhaseCount = 12;
+
+    // Bits of flags.
+    static constexpr std::uint8_t kHasPrevious = 1u << 0;
+    static constexpr std::uint8_t kHasCurrent = 1u << 1;
+    static constexpr std::uint8_t kWalrusPending = 1u << 2;
+    static constexpr std::uint8_t kWalrusActive = 1u << 3;
+    static constexpr std::uint8_t kExtraFlip = 1u << 4;
+
+    Xoshiro256 rubyGenerator;
+    std::uint32_t faceUp{0};
+    std::uint32_t blocked{0};
+    std::array<CardId, Card::kCount> cards{};
+    CardId previous{0};
+    CardId current{0};
+    std::uint8_t version{kVersion};
+    std::uint8_t flags{0};
+    std::uint8_t round{0};
+    std::uint8_t playerCount{0};
+    // Seat on turn, the engine's turn phase and the cell whose ability is being resolved.
+    std::uint8_t currentPlayer{0};
+    std::uint8_t phase{0};
+    std::uint8_t origin{0};
+    std::uint8_t skipCount{0};
+    // One bit per seat; bits at or above playerCount are clear.
+    std::uint8_t activeMask{0};
+    std::uint8_t endOfGameMask{0};
+    // Two bits per seat (Side value).
+    std::uint8_t sides{0};
+    std::array<std::uint8_t, kMaxPlayers> rubies{};
+    // Ruby deck storage order; the next draw is rubyDeck[rubyCount - 1].
+    std::uint8_t rubyCount{0};
+    std::array<std::uint8_t, kMaxRubies> rubyDeck{};
+};
+
+// Parameters: snapshot (const GameSnapshot&). Returns true if every field is in range
+// (version, card ids, player and ruby counts, seat masks, turn phase), so it is safe to restore.
+bool is_valid(const GameSnapshot& snapshot);
+
+// Parameters: os (std::ostream&), snapshot (const GameSnapshot&). Writes the raw bytes (native byte order).
+void write_snapshot(std::ostream& os, const GameSnapshot& snapshot);
+// Parameters: is (std::istream&), snapshot (GameSnapshot&). Returns false on a short read or invalid data.
+bool read_snapshot(std::istream& is, GameSnapshot& snapshot);
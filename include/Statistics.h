@@ -0,0 +1,113 @@
+#pragma once
+
+#include "Enums.h"
+#include "GameObserver.h"
+#include "Seating.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+// Streaming histogram of small non-negative integers (flips per round, rubies per game). Values
+// from kBins - 1 upwards share the last bin; count, sum, min and max are exact. Quantiles are exact
+// below the last bin, so no samples are stored however many games are aggregated.
+class Histogram {
+public:
+    static constexpr std::size_t kBins = 64;
+
+    // Parameters: value (std::uint32_t). Records one sample.
+    void add(std::uint32_t value);
+    // Parameters: other (const Histogram&). Adds every sample of other.
+    void merge(const Histogram& other);
+
+    std::uint64_t count() const { return m_count; }
+    std::uint64_t sum() const { return m_sum; }
+    std::uint32_t min() const { return m_count == 0 ? 0 : m_min; }
+    std::uint32_t max() const { return m_max; }
+    // No parameters. Returns the arithmetic mean (0 when empty).
+    double mean() const;
+    // Parameters: q (double, 0..1). Returns the smallest value v with at least q of the samples <= v.
+    std::uint32_t quantile(double q) const;
+    // Parameters: bin (std::size_t, < kBins). Returns the number of samples in that bin.
+    std::uint64_t bin(std::size_t bin) const { return m_bins[bin]; }
+
+private:
+    std::array<std::uint64_t, kBins> m_bins{};
+    std::uint64_t m_count{0};
+    std::uint64_t m_sum{0};
+    std::uint32_t m_min{0xFFFFFFFFu};
+    std::uint32_t m_max{0};
+};
+
+// Ways a seat leaves a round before it ends.
+enum class Elimination { Mismatch, NoCardsLeft };
+
+// Aggregated metrics of a batch of games. Only counters and histograms, so per-thread instances
+// merge by addition and the totals do not depend on how games were spread across threads.
+struct SimulationStats {
+    static constexpr std::size_t kSides = 4;
+    static constexpr std::size_t kAnimals = 5;
+
+    std::uint64_t games{0};
+    std::uint64_t rounds{0};
+    // Rounds in which every seat was eliminated, so no ruby was awarded.
+    std::uint64_t roundsWithoutWinner{0};
+    // Indexed by Side: games played from that side, games won (ties credit every tied seat). Only
+    // classic tables count here; on larger tables several seats share a side.
+    std::array<std::uint64_t, kSides> gamesBySide{};
+    std::array<std::uint64_t, kSides> winsBySide{};
+    // Indexed by seat: games played from that seat, games won (ties credit every tied seat).
+    std::array<std::uint64_t, kMaxSeats> gamesBySeat{};
+    std::array<std::uint64_t, kMaxSeats> winsBySeat{};
+    std::array<std::uint64_t, 2> eliminations{};
+    // Turns lost to a turtle.
+    std::uint64_t skippedTurns{0};
+    // Indexed by FaceAnimal: abilities that took effect, abilities declined or without a legal
+    // target, and rounds won by a seat that used that ability during the round.
+    std::array<std::uint64_t, kAnimals> abilityFired{};
+    std::array<std::uint64_t, kAnimals> abilityWasted{};
+    std::array<std::uint64_t, kAnimals> abilityUserWonRound{};
+    Histogram flipsPerRound;
+    Histogram rubiesPerSeat;
+    Histogram winningRubies;
+
+    // Parameters: other (const SimulationStats&). Adds other's counters and histograms.
+    void merge(const SimulationStats& other);
+};
+
+// Size of the unit the CPU keeps coherent; per-thread data must not share one.
+constexpr std::size_t kCacheLine = 64;
+
+// Per-thread slot padded on both sides so that no other data shares its cache lines, whatever
+// alignment the allocator gives (C++14 operator new ignores over-aligned types).
+template <typename T>
+struct CacheLinePadded {
+    char before[kCacheLine];
+    T value;
+    char after[kCacheLine];
+};
+
+// Observer that folds one game at a time into a SimulationStats without storing any event.
+class StatsCollector : public GameObserver {
+public:
+    // Parameters: stats (SimulationStats&) destination, owned by the calling thread.
+    explicit StatsCollector(SimulationStats& stats);
+
+    void onEvent(const Game& game, const GameEvent& event) override;
+
+private:
+    // Parameters: animal (FaceAnimal), player (std::size_t), fired (bool) false when declined or impossible.
+    void ability(FaceAnimal animal, std::size_t player, bool fired);
+
+    SimulationStats& m_stats;
+    std::uint32_t m_roundFlips{0};
+    // Per animal, the seats whose ability took effect this round.
+    std::array<std::uint32_t, SimulationStats::kAnimals> m_abilityUsers{};
+};
+
+// Parameters: os (std::ostream&), stats (const SimulationStats&). Writes a compact human-readable summary.
+void write_report(std::ostream& os, const SimulationStats& stats);
+// Parameters: os (std::ostream&), stats (const SimulationStats&). Writes "metric,key,value" rows
+// (with a header line), including every non-empty histogram bin.
+void write_csv(std::ostream& os, const SimulationStats& stats);
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads with one task queue each. Idle workers steal from the others' queues.
+class WorkStealingPool {
+public:
+    // Parameters: threads (std::size_t), 0 selects std::thread::hardware_concurrency().
+    explicit WorkStealingPool(std::size_t threads = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // No parameters. Returns the number of worker threads.
+    std::size_t size() const;
+
+    // Parameters: count (std::size_t), task (index, worker). Runs task for every index in [0, count)
+    // and blocks until all are done. The first exception thrown by a task is rethrown here.
+    void parallelFor(std::size_t count, const std::function<void(std::size_t, std::size_t)>& task);
+
+private:
+    // Contiguous block of indices queued as one unit of work.
+    struct Range {
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Range> ranges;
+    };
+
+    void workerLoop(std::size_t worker);
+    bool popLocal(std::size_t worker, Range& range);
+    bool steal(std::size_t worker, Range& range);
+    void runRange(std::size_t worker, const Range& range);
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    const std::function<void(std::size_t, std::size_t)>* m_task{nullptr};
+    std::size_t m_generation{0};
+    std::size_t m_remaining{0};
+    std::exception_ptr m_error;
+    bool m_stopping{false};
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+// Optional hot-path tracing. Configure with -DMEMOARRR_TRACE=ON to record a complete event for
+// every TRACE_SCOPE into a per-thread ring buffer; otherwise TRACE_SCOPE expands to nothing and
+// no recording code is compiled. write_chrome_trace() exports the buffers as Chrome trace-event
+// JSON, which chrome://tracing and ui.perfetto.dev open directly.
+#ifndef MEMOARRR_TRACE
+#define MEMOARRR_TRACE 0
+#endif
+
+constexpr bool kTraceEnabled = MEMOARRR_TRACE != 0;
+
+// Events kept per thread; older ones are overwritten once a thread records more.
+constexpr std::size_t kTraceCapacity = std::size_t{1} << 16;
+
+#if MEMOARRR_TRACE
+// No parameters. Returns nanoseconds on a monotonic clock.
+std::uint64_t trace_now();
+// Parameters: name (const char*, string literal), start/end (std::uint64_t) trace_now() values.
+// Appends one event to the calling thread's buffer; never locks after the thread's first event.
+void trace_record(const char* name, std::uint64_t start, std::uint64_t end);
+
+// Records the time between construction and destruction under one name.
+class TraceScope {
+public:
+    // Parameters: name (const char*), must outlive the export (use a string literal).
+    explicit TraceScope(const char* name) : m_name(name), m_start(trace_now()) {}
+    ~TraceScope() { trace_record(m_name, m_start, trace_now()); }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_name;
+    std::uint64_t m_start;
+};
+
+#define MEMOARRR_TRACE_JOIN2(a, b) a##b
+#define MEMOARRR_TRACE_JOIN(a, b) MEMOARRR_TRACE_JOIN2(a, b)
+#define TRACE_SCOPE(name) TraceScope MEMOARRR_TRACE_JOIN(traceScope, __LINE__)(name)
+#else
+#define TRACE_SCOPE(name) static_cast<void>(0)
+#endif
+
+// No parameters. Drops every recorded event (call while no thread is recording).
+void clear_trace();
+// Parameters: os (std::ostream&). Writes {"traceEvents":[...]} with one complete ("X") event per
+// recorded scope, tid being the order in which threads first recorded. Call once recording threads
+// are idle (e.g. after Simulator::run). Returns the number of events written (always 0 when tracing
+// is compiled out).
+std::size_t write_chrome_trace(std::ostream& os);
@@ -1,210 +1,176 @@
 // Board implementation: manages grid state, card storage, and rendering.
 #include "Board.h"
 
+#include "Renderer.h"
+
 #include <ostream>
-#include <string>
-#include <utility>
-
-namespace {
-// Description: Represents a generic face-down cell with 'z' markers.
-// Returns: std::string "zzz" used when printing hidden cards.
-std::string face_down_row() {
-    return std::string("zzz");
-}
-
-// Description: Produces a blank 3-character cell for empty slots (e.g., volcano).
-// Returns: std::string containing three spaces.
-std::string empty_row() {
-    return std::string("   ");
-}
-}
-
-Board::Board(DeckFactory<Card>& deck, std::vector<std::unique_ptr<Card>>& storage)
-    : m_cardStorage(storage) {
-    for (std::size_t row = 0; row < 5; ++row) {
-        for (std::size_t col = 0; col < 5; ++col) {
-            Letter letter = static_cast<Letter>(row);
-            Number number = static_cast<Number>(col);
-            if (isCenter(letter, number)) {
-                continue;
-            }
-            Card* next = deck.getNext();
-            if (!next) {
-                throw NoMoreCards("Not enough cards to populate the board");
-            }
-            m_cardStorage.emplace_back(next);
-            m_grid[row][col].card = m_cardStorage.back().get();
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<Board>::value, "Board must stay trivially copyable");
+
+template <class Geometry>
+BasicBoard<Geometry>::BasicBoard(DeckFactory<BasicCard<Geometry>, Geometry::kCardCount>& deck) {
+    const bool dealt = m_grid.deal([&deck](CardId& id) {
+        const BasicCard<Geometry>* next = deck.getNext();
+        if (next == nullptr) {
+            return false;
         }
+        id = next->id();
+        return true;
+    });
+    if (!dealt) {
+        throw NoMoreCards("Not enough cards to populate the board");
     }
 }
 
-bool Board::isFaceUp(const Letter& letter, const Number& number) const {
-    return at(letter, number).faceUp;
+template <class Geometry>
+bool BasicBoard<Geometry>::isFaceUp(const Letter& letter, const Number& number) const {
+    return m_grid.isFaceUpAt(at(letter, number));
 }
 
-bool Board::turnFaceUp(const Letter& letter, const Number& number) {
-    Cell& cell = at(letter, number);
-    if (cell.card == nullptr) {
+template <class Geometry>
+bool BasicBoard<Geometry>::turnFaceUp(const Letter& letter, const Number& number) {
+    const std::size_t index = at(letter, number);
+    if (!m_grid.isOccupiedAt(index)) {
         throw OutOfRange("Empty position");
     }
-    if (cell.faceUp) {
+    if (m_grid.isFaceUpAt(index)) {
         return false;
     }
-    cell.faceUp = true;
+    m_grid.turnFaceUpAt(index);
     return true;
 }
 
-bool Board::turnFaceDown(const Letter& letter, const Number& number) {
-    Cell& cell = at(letter, number);
-    if (cell.card == nullptr) {
+template <class Geometry>
+bool BasicBoard<Geometry>::turnFaceDown(const Letter& letter, const Number& number) {
+    const std::size_t index = at(letter, number);
+    if (!m_grid.isOccupiedAt(index)) {
         throw OutOfRange("Empty position");
     }
-    if (!cell.faceUp) {
+    if (!m_grid.isFaceUpAt(index)) {
         return false;
     }
-    cell.faceUp = false;
+    m_grid.turnFaceDownAt(index);
     return true;
 }
 
-Card* Board::getCard(const Letter& letter, const Number& number) {
-    return at(letter, number).card;
+template <class Geometry>
+BasicCard<Geometry> BasicBoard<Geometry>::getCard(const Letter& letter, const Number& number) const {
+    return BasicCard<Geometry>::fromId(m_grid.cardAt(at(letter, number)));
 }
 
-void Board::setCard(const Letter& letter, const Number& number, Card* card) {
-    Cell& cell = at(letter, number);
-    cell.card = card;
+template <class Geometry>
+void BasicBoard<Geometry>::setCard(const Letter& letter, const Number& number, const BasicCard<Geometry>& card) {
+    m_grid.placeAt(at(letter, number), card.id());
 }
 
-void Board::allFacesDown() {
-    for (auto& row : m_grid) {
-        for (auto& cell : row) {
-            cell.faceUp = false;
-            cell.blocked = false;
-        }
-    }
+template <class Geometry>
+void BasicBoard<Geometry>::allFacesDown() {
+    m_grid.allFacesDown();
 }
 
-bool Board::isBlocked(const Letter& letter, const Number& number) const {
-    return at(letter, number).blocked;
+template <class Geometry>
+bool BasicBoard<Geometry>::isBlocked(const Letter& letter, const Number& number) const {
+    return m_grid.isBlockedAt(at(letter, number));
 }
 
-void Board::setBlocked(const Letter& letter, const Number& number, bool blocked) {
-    at(letter, number).blocked = blocked;
+template <class Geometry>
+void BasicBoard<Geometry>::setBlocked(const Letter& letter, const Number& number, bool blocked) {
+    m_grid.setBlockedAt(at(letter, number), blocked);
 }
 
-void Board::clearBlocked() {
-    for (auto& row : m_grid) {
-        for (auto& cell : row) {
-            cell.blocked = false;
-        }
+template <class Geometry>
+void BasicBoard<Geometry>::clearBlocked() {
+    m_grid.clearBlocked();
+}
+
+template <class Geometry>
+bool BasicBoard<Geometry>::hasFaceDownCards() const {
+    return Ops::any(faceDownMask());
+}
+
+template <class Geometry>
+void BasicBoard<Geometry>::swapCells(const Position& first, const Position& second) {
+    swapCellsAt(at(first.letter, first.number), at(second.letter, second.number));
+}
+
+template <class Geometry>
+bool BasicBoard<Geometry>::isPlayable(const Position& position) const {
+    const std::size_t row = to_index(position.letter);
+    const std::size_t col = to_index(position.number);
+    if (row >= kRows || col >= kColumns) {
+        return false;
     }
+    return m_grid.isOccupiedAt(row * kColumns + col);
 }
 
-bool Board::hasFaceDownCards() const {
-    for (const auto& row : m_grid) {
-        for (const auto& cell : row) {
-            if (cell.card && !cell.faceUp) {
-                return true;
-            }
-        }
+template <class Geometry>
+FlipStatus BasicBoard<Geometry>::tryTurnFaceUp(const Position& position, bool blockActive) {
+    if (!isPlayable(position)) {
+        return FlipStatus::NotPlayable;
+    }
+    const std::size_t index = indexOf(position);
+    if (isFaceUpAt(index)) {
+        return FlipStatus::AlreadyFaceUp;
     }
-    return false;
+    if (blockActive && isBlockedAt(index)) {
+        return FlipStatus::Blocked;
+    }
+    turnFaceUpAt(index);
+    return FlipStatus::Flipped;
 }
 
-void Board::swapCells(const Position& first, const Position& second) {
-    Cell& a = at(first.letter, first.number);
-    Cell& b = at(second.letter, second.number);
-    std::swap(a, b);
+template <class Geometry>
+void BasicBoard<Geometry>::restoreState(const std::array<CardId, kCells>& cards, const Mask& faceUp,
+                                        const Mask& blocked) {
+    m_grid.restore(cards, faceUp, blocked);
 }
 
-std::vector<std::pair<Position, const Card*>> Board::faceUpCards() const {
-    std::vector<std::pair<Position, const Card*>> result;
-    for (std::size_t row = 0; row < 5; ++row) {
-        for (std::size_t col = 0; col < 5; ++col) {
-            const Cell& cell = m_grid[row][col];
-            if (cell.card && cell.faceUp) {
-                result.push_back({Position{static_cast<Letter>(row), static_cast<Number>(col)}, cell.card});
-            }
-        }
-    }
+template <class Geometry>
+std::vector<std::pair<Position, BasicCard<Geometry>>> BasicBoard<Geometry>::faceUpCards() const {
+    std::vector<std::pair<Position, BasicCard<Geometry>>> result;
+    result.reserve(Ops::count(faceUpMask()));
+    forEachFaceUp([&result](const Position& pos, const BasicCard<Geometry>& card) { result.push_back({pos, card}); });
     return result;
 }
 
-bool Board::isCenter(Letter letter, Number number) {
-    return letter == Letter::C && number == Number::Three;
+template <class Geometry>
+std::size_t BasicBoard<Geometry>::indexOf(const Position& position) {
+    return to_index(position.letter) * kColumns + to_index(position.number);
 }
 
-Board::Cell& Board::at(const Letter& letter, const Number& number) {
-    if (isCenter(letter, number)) {
-        throw OutOfRange("Center position is empty");
-    }
-    std::size_t row = to_index(letter);
-    std::size_t col = to_index(number);
-    if (row >= m_grid.size() || col >= m_grid[row].size()) {
-        throw OutOfRange("Position outside of board");
-    }
-    return m_grid[row][col];
+template <class Geometry>
+Position BasicBoard<Geometry>::positionOf(std::size_t index) {
+    return Position{static_cast<Letter>(index / kColumns), static_cast<Number>(index % kColumns)};
 }
 
-const Board::Cell& Board::at(const Letter& letter, const Number& number) const {
+template <class Geometry>
+bool BasicBoard<Geometry>::isCenter(Letter letter, Number number) {
+    return to_index(letter) * kColumns + to_index(number) == Geometry::kCenter;
+}
+
+template <class Geometry>
+std::size_t BasicBoard<Geometry>::at(const Letter& letter, const Number& number) {
     if (isCenter(letter, number)) {
         throw OutOfRange("Center position is empty");
     }
     std::size_t row = to_index(letter);
     std::size_t col = to_index(number);
-    if (row >= m_grid.size() || col >= m_grid[row].size()) {
+    if (row >= kRows || col >= kColumns) {
         throw OutOfRange("Position outside of board");
     }
-    return m_grid[row][col];
+    return row * kColumns + col;
 }
 
-// Description: Streams either the full base board grid or blank placeholders per cell.
+template class BasicBoard<ClassicGeometry>;
+template class BasicBoard<Geometry7x7>;
+template class BasicBoard<Geometry9x9>;
+
+// Description: Streams the full base board grid in a single write.
 // Parameters: os (std::ostream&), board (const Board&).
 // Returns: std::ostream& allowing chained output.
 std::ostream& operator<<(std::ostream& os, const Board& board) {
-    for (std::size_t row = 0; row < 5; ++row) {
-        Letter letter = static_cast<Letter>(row);
-        for (std::size_t inner = 0; inner < 3; ++inner) {
-            os << (inner == 1 ? letter_symbol(letter) : ' ') << ' ';
-            for (std::size_t col = 0; col < 5; ++col) {
-                Number number = static_cast<Number>(col);
-                if (col > 0) {
-                    os << ' ';
-                }
-                if (Board::isCenter(letter, number)) {
-                    os << empty_row();
-                    continue;
-                }
-                const auto& cell = board.at(letter, number);
-                if (!cell.card) {
-                    os << empty_row();
-                } else if (!cell.faceUp) {
-                    os << face_down_row();
-                } else {
-                    os << (*cell.card)(inner);
-                }
-            }
-            os << '\n';
-        }
-        if (row + 1 < 5) {
-            os << "  ";
-            for (std::size_t col = 0; col < 5; ++col) {
-                if (col > 0) {
-                    os << ' ';
-                }
-                os << empty_row();
-            }
-            os << '\n';
-        }
-    }
-
-    os << "  ";
-    for (std::size_t col = 0; col < 5; ++col) {
-        if (col > 0) {
-            os << ' ';
-        }
-        os << ' ' << number_symbol(static_cast<Number>(col)) << ' ';
-    }
-    os << '\n';
+    FrameWriter frame(os);
+    frame.appendBoard(board);
     return os;
 }
@@ -3,36 +3,74 @@
 
 #include <ostream>
 #include <stdexcept>
+#include <type_traits>
 
-Card::Card(FaceAnimal animal, FaceBackground background)
-    : m_animal(animal), m_background(background) {}
+static_assert(sizeof(Card) == 1, "Card must stay a one-byte value");
+static_assert(std::is_trivially_copyable<Card>::value, "Card must be trivially copyable");
+static_assert(ClassicGeometry::kAnimals == static_cast<std::size_t>(FaceAnimal::Walrus) + 1 &&
+                  ClassicGeometry::kBackgrounds == static_cast<std::size_t>(FaceBackground::Yellow) + 1,
+              "The classic alphabet is the FaceAnimal x FaceBackground enums");
 
-std::size_t Card::getNRows() const {
+template <class Geometry>
+BasicCard<Geometry>::BasicCard(CardId id) : m_id(id) {}
+
+template <class Geometry>
+BasicCard<Geometry> BasicCard<Geometry>::fromId(CardId id) {
+    if (id >= kCount) {
+        throw std::out_of_range("Card id");
+    }
+    return BasicCard(id);
+}
+
+template <class Geometry>
+CardId BasicCard<Geometry>::id() const {
+    return m_id;
+}
+
+template <class Geometry>
+std::size_t BasicCard<Geometry>::getNRows() const {
     return 3;
 }
 
-std::string Card::operator()(std::size_t row) const {
+template <class Geometry>
+std::string BasicCard<Geometry>::operator()(std::size_t row) const {
     if (row >= getNRows()) {
         throw std::out_of_range("Card row");
     }
-    const char bg = background_symbol(m_background);
+    const char bg = background_symbol(static_cast<FaceBackground>(*this));
     if (row == 1) {
         std::string middle(1, bg);
-        middle += animal_symbol(m_animal);
+        middle += animal_symbol(static_cast<FaceAnimal>(*this));
         middle += bg;
         return middle;
     }
     return std::string(3, bg);
 }
 
-Card::operator FaceAnimal() const {
-    return m_animal;
+template <class Geometry>
+BasicCard<Geometry>::operator FaceAnimal() const {
+    return static_cast<FaceAnimal>(Geometry::animalOf(m_id));
 }
 
-Card::operator FaceBackground() const {
-    return m_background;
+template <class Geometry>
+BasicCard<Geometry>::operator FaceBackground() const {
+    return static_cast<FaceBackground>(Geometry::backgroundOf(m_id));
 }
 
+template <class Geometry>
+bool BasicCard<Geometry>::operator==(const BasicCard& other) const {
+    return m_id == other.m_id;
+}
+
+template <class Geometry>
+bool BasicCard<Geometry>::operator!=(const BasicCard& other) const {
+    return m_id != other.m_id;
+}
+
+template class BasicCard<ClassicGeometry>;
+template class BasicCard<Geometry7x7>;
+template class BasicCard<Geometry9x9>;
+
 std::ostream& operator<<(std::ostream& os, const Card& card) {
     for (std::size_t row = 0; row < card.getNRows(); ++row) {
         os << card(row);
@@ -0,0 +1,481 @@
+// Engine implementation: the console-free, resumable turn state machine shared by every front end and
+// every board geometry.
+#include "Engine.h"
+
+#include "BasicEngine.h"
+#include "Seating.h"
+#include "Trace.h"
+
+#include <stdexcept>
+
+namespace {
+// Description: Checks whether a position is one of the cells of a mask.
+// Parameters: options (cell mask of the geometry), target (const Position&).
+// Returns: true when target is one of the options.
+template <class Geometry>
+bool contains(const typename Geometry::Mask& options, const Position& target) {
+    return MaskOps<typename Geometry::Mask>::test(options, BasicBoard<Geometry>::indexOf(target));
+}
+}
+
+template <class Geometry>
+GameEngine<Geometry>::GameEngine(BasicGame<Geometry>& game, const Rules& rules, RubisDeck& rubisDeck)
+    : m_game(game), m_rules(rules), m_rubisDeck(rubisDeck) {
+    if (game.rulesMode() == RulesMode::Expert) {
+        usePolicy<ExpertRules>();
+    } else {
+        usePolicy<BaseRules>();
+    }
+}
+
+template <class Geometry>
+void GameEngine<Geometry>::setAgent(std::size_t playerIndex, BasicAgent<Geometry>& agent) {
+    if (m_agents.size() <= playerIndex) {
+        m_agents.resize(playerIndex + 1, nullptr);
+    }
+    m_agents[playerIndex] = &agent;
+}
+
+template <class Geometry>
+void GameEngine<Geometry>::addObserver(BasicGameObserver<Geometry>& observer) {
+    m_observers.push_back(&observer);
+}
+
+template <class Geometry>
+void GameEngine<Geometry>::playGame() {
+    TRACE_SCOPE("game");
+    if (m_phase == Phase::Finished) {
+        m_phase = Phase::NotStarted;
+    }
+    (this->*m_advance)();
+    if (m_phase != Phase::Finished) {
+        throw std::logic_error("No agent assigned to player");
+    }
+}
+
+template <class Geometry>
+void GameEngine<Geometry>::playRound() {
+    TRACE_SCOPE("round");
+    if (m_phase == Phase::NotStarted || m_phase == Phase::GameEnd || m_phase == Phase::Finished) {
+        m_phase = Phase::RoundStart;
+    }
+    if (m_phase != Phase::RoundStart) {
+        throw std::logic_error("A round is already in progress");
+    }
+    const int round = m_game.getRound();
+    while (m_game.getRound() == round) {
+        if (!(this->*m_step)()) {
+            throw std::logic_error("No agent assigned to player");
+        }
+    }
+}
+
+template <class Geometry>
+const BasicInputRequest<Geometry>& GameEngine<Geometry>::advance() {
+    return (this->*m_advance)();
+}
+
+template <class Geometry>
+const BasicInputRequest<Geometry>& GameEngine<Geometry>::pending() const {
+    return m_request;
+}
+
+template <class Geometry>
+bool GameEngine<Geometry>::finished() const {
+    return m_phase == Phase::Finished;
+}
+
+template <class Geometry>
+bool GameEngine<Geometry>::submitFlip(const Position& position) {
+    expect(Phase::Flip);
+    return (this->*m_flip)(position);
+}
+
+template <class Geometry>
+bool GameEngine<Geometry>::submitOctopusTarget(const Position& target) {
+    expect(Phase::Octopus);
+    return resolveOctopus(target);
+}
+
+template <class Geometry>
+bool GameEngine<Geometry>::submitPenguinTarget(bool flipDown, const Position& target) {
+    expect(Phase::Penguin);
+    return resolvePenguin(flipDown, target);
+}
+
+template <class Geometry>
+bool GameEngine<Geometry>::submitWalrusBlock(bool block, const Position& target) {
+    expect(Phase::Walrus);
+    return resolveWalrus(block, target);
+}
+
+template <>
+GameSnapshot Engine::snapshot() const {
+    GameSnapshot snapshot;
+    m_game.saveState(snapshot);
+    m_rubisDeck.saveState(snapshot);
+    snapshot.phase = static_cast<std::uint8_t>(m_phase);
+    snapshot.currentPlayer = static_cast<std::uint8_t>(m_turnIndex);
+    snapshot.origin = static_cast<std::uint8_t>(Board::indexOf(m_abilityOrigin));
+    snapshot.skipCount = static_cast<std::uint8_t>(m_skipCount);
+    if (m_extraFlip) {
+        snapshot.flags |= GameSnapshot::kExtraFlip;
+    }
+    if (m_walrusBlockPending) {
+        snapshot.flags |= GameSnapshot::kWalrusPending;
+    }
+    if (m_walrusBlockActive) {
+        snapshot.flags |= GameSnapshot::kWalrusActive;
+    }
+    return snapshot;
+}
+
+template <>
+void Engine::restore(const GameSnapshot& snapshot) {
+    static_assert(static_cast<std::uint8_t>(Phase::Finished) + 1 == GameSnapshot::kPhaseCount,
+                  "GameSnapshot::kPhaseCount must match Engine::Phase");
+    m_game.restoreState(snapshot);
+    m_rubisDeck.restoreState(snapshot);
+    m_phase = static_cast<Phase>(snapshot.phase);
+    m_turnIndex = snapshot.currentPlayer;
+    m_abilityOrigin = Board::positionOf(snapshot.origin);
+    m_skipCount = snapshot.skipCount;
+    m_extraFlip = (snapshot.flags & GameSnapshot::kExtraFlip) != 0;
+    m_walrusBlockPending = (snapshot.flags & GameSnapshot::kWalrusPending) != 0;
+    m_walrusBlockActive = (snapshot.flags & GameSnapshot::kWalrusActive) != 0;
+
+    // Rebuild the pending request of a decision phase.
+    switch (m_phase) {
+    case Phase::Flip:
+    case Phase::Walrus:
+        await(m_phase);
+        break;
+    case Phase::Octopus:
+        await(m_phase, octopusTargets(m_abilityOrigin));
+        break;
+    case Phase::Penguin:
+        await(m_phase, penguinTargets(m_abilityOrigin));
+        break;
+    default:
+        m_request.kind = InputKind::None;
+        m_request.options.clear();
+        m_request.optionMask = 0;
+        break;
+    }
+}
+
+template <class Geometry>
+bool GameEngine<Geometry>::canFlip(const Position& position, bool blockActive) const {
+    const BasicBoard<Geometry>& board = m_game.board();
+    return board.isPlayable(position) && contains<Geometry>(board.flippableMask(blockActive), position);
+}
+
+template <class Geometry>
+typename GameEngine<Geometry>::Mask GameEngine<Geometry>::octopusTargets(const Position& origin) const {
+    return GridTables<Geometry>::kMasks.neighbours[BasicBoard<Geometry>::indexOf(origin)] &
+           m_game.board().occupiedMask();
+}
+
+template <class Geometry>
+typename GameEngine<Geometry>::Mask GameEngine<Geometry>::penguinTargets(const Position& current) const {
+    return m_game.board().faceUpMask() & ~MaskOps<Mask>::bit(BasicBoard<Geometry>::indexOf(current));
+}
+
+template <class Geometry>
+void GameEngine<Geometry>::startRound() {
+    GameEvent start = makeEvent(EventType::RoundStart);
+    start.value = m_game.getRound() + 1;
+    emit(start);
+
+    resetRound();
+    revealInitialCards();
+    // Classic tables open every round with seat 0. Larger tables run out of cards before every seat
+    // has played, so they carry the turn order over: the seat after the last one to flip opens.
+    const bool carryOver = m_game.players().size() > kClassicSeats && m_game.getRound() > 0;
+    m_turnIndex = carryOver ? m_game.nextActivePlayer(m_lastTurn) : 0;
+    m_phase = Phase::TurnStart;
+}
+
+template <class Geometry>
+void GameEngine<Geometry>::startTurn() {
+    if (m_rules.roundOver(m_game)) {
+        m_phase = Phase::RoundEnd;
+        return;
+    }
+    Player& player = m_game.players().at(m_turnIndex);
+    if (!player.isActive()) {
+        m_phase = Phase::EndTurn;
+        return;
+    }
+    m_game.setCurrentPlayerIndex(m_turnIndex);
+
+    if (m_skipCount > 0) {
+        --m_skipCount;
+        m_phase = Phase::EndTurn;
+        emit(makeEvent(EventType::Skipped, m_turnIndex));
+        return;
+    }
+
+    if (!m_game.board().hasFaceDownCards()) {
+        m_game.setPlayerActive(m_turnIndex, false);
+        m_phase = Phase::EndTurn;
+        emit(makeEvent(EventType::NoCardsLeft, m_turnIndex));
+        return;
+    }
+
+    if (m_walrusBlockPending) {
+        m_walrusBlockActive = true;
+        m_walrusBlockPending = false;
+        emit(makeEvent(EventType::BlockEnforced, m_turnIndex));
+    }
+    m_extraFlip = false;
+    m_lastTurn = m_turnIndex;
+    await(Phase::Flip);
+}
+
+template <class Geometry>
+bool GameEngine<Geometry>::askOctopus() {
+    if (!hasAgent(m_turnIndex)) {
+        return false;
+    }
+    TRACE_SCOPE("input.octopus");
+    const Player& player = m_game.players().at(m_turnIndex);
+    const Position target =
+        agentFor(m_turnIndex).chooseOctopusTarget(m_game, player, m_abilityOrigin, m_request.options);
+    if (!resolveOctopus(target)) {
+        throw std::logic_error("Agent chose an invalid octopus target");
+    }
+    return true;
+}
+
+template <class Geometry>
+bool GameEngine<Geometry>::askPenguin() {
+    if (!hasAgent(m_turnIndex)) {
+        return false;
+    }
+    TRACE_SCOPE("input.penguin");
+    const Player& player = m_game.players().at(m_turnIndex);
+    Position target;
+    const bool flipDown = agentFor(m_turnIndex).choosePenguinTarget(m_game, player, m_request.options, target);
+    if (!resolvePenguin(flipDown, target)) {
+        throw std::logic_error("Agent chose an invalid penguin target");
+    }
+    return true;
+}
+
+template <class Geometry>
+bool GameEngine<Geometry>::askWalrus() {
+    if (!hasAgent(m_turnIndex)) {
+        return false;
+    }
+    TRACE_SCOPE("input.walrus");
+    const Player& player = m_game.players().at(m_turnIndex);
+    Position target;
+    const bool block = agentFor(m_turnIndex).chooseWalrusBlock(m_game, player, target);
+    if (!resolveWalrus(block, target)) {
+        throw std::logic_error("Agent chose an invalid walrus block");
+    }
+    return true;
+}
+
+template <class Geometry>
+bool GameEngine<Geometry>::resolveOctopus(const Position& target) {
+    TRACE_SCOPE("ability.octopus");
+    if (!contains<Geometry>(m_request.optionMask, target)) {
+        return false;
+    }
+    m_game.board().swapCellsAt(BasicBoard<Geometry>::indexOf(m_abilityOrigin), BasicBoard<Geometry>::indexOf(target));
+    m_request.kind = InputKind::None;
+    m_phase = Phase::AfterFlip;
+    GameEvent event = abilityEvent(EventType::OctopusSwap);
+    event.target = target;
+    emit(event);
+    return true;
+}
+
+template <class Geometry>
+bool GameEngine<Geometry>::resolvePenguin(bool flipDown, const Position& target) {
+    TRACE_SCOPE("ability.penguin");
+    if (flipDown && !contains<Geometry>(m_request.optionMask, target)) {
+        return false;
+    }
+    m_request.kind = InputKind::None;
+    m_phase = Phase::AfterFlip;
+    if (!flipDown) {
+        emit(abilityEvent(EventType::PenguinSkipped));
+        return true;
+    }
+    m_game.board().turnFaceDownAt(BasicBoard<Geometry>::indexOf(target));
+    GameEvent event = abilityEvent(EventType::PenguinFlipDown);
+    event.target = target;
+    emit(event);
+    return true;
+}
+
+template <class Geometry>
+bool GameEngine<Geometry>::resolveWalrus(bool block, const Position& target) {
+    TRACE_SCOPE("ability.walrus");
+    if (block && !canFlip(target, false)) {
+        return false;
+    }
+    m_request.kind = InputKind::None;
+    m_phase = Phase::AfterFlip;
+    if (!block) {
+        emit(abilityEvent(EventType::WalrusSkipped));
+        return true;
+    }
+    m_game.board().blockOnlyAt(BasicBoard<Geometry>::indexOf(target));
+    GameEvent event = abilityEvent(EventType::WalrusBlock);
+    event.target = target;
+    emit(event);
+    m_walrusBlockPending = true;
+    return true;
+}
+
+template <class Geometry>
+void GameEngine<Geometry>::finishRound() {
+    awardRubies();
+    emit(makeEvent(EventType::RoundEnd));
+    m_game.incrementRound();
+    m_phase = m_rules.gameOver(m_game) ? Phase::GameEnd : Phase::RoundStart;
+}
+
+// Enters a decision phase and describes it in m_request.
+template <class Geometry>
+void GameEngine<Geometry>::await(Phase phase, Mask options) {
+    m_phase = phase;
+    m_request.player = m_turnIndex;
+    m_request.origin = m_abilityOrigin;
+    // Refilled in place so that the vector's capacity is reused from one decision to the next.
+    m_request.optionMask = options;
+    m_request.options.clear();
+    for (; MaskOps<Mask>::any(options); options = MaskOps<Mask>::dropLowest(options)) {
+        m_request.options.push_back(BasicBoard<Geometry>::positionOf(MaskOps<Mask>::lowest(options)));
+    }
+    m_request.blockActive = false;
+    switch (phase) {
+    case Phase::Flip:
+        m_request.kind = InputKind::Flip;
+        m_request.blockActive = m_walrusBlockActive && hasFlippableCard(true);
+        break;
+    case Phase::Octopus:
+        m_request.kind = InputKind::OctopusTarget;
+        break;
+    case Phase::Penguin:
+        m_request.kind = InputKind::PenguinTarget;
+        break;
+    default:
+        m_request.kind = InputKind::WalrusBlock;
+        break;
+    }
+}
+
+template <class Geometry>
+void GameEngine<Geometry>::expect(Phase phase) const {
+    if (m_phase != phase) {
+        throw std::logic_error("Engine is not waiting for that decision");
+    }
+}
+
+template <class Geometry>
+void GameEngine<Geometry>::resetRound() {
+    BasicBoard<Geometry>& board = m_game.board();
+    board.allFacesDown();
+    board.clearBlocked();
+    m_walrusBlockPending = false;
+    m_walrusBlockActive = false;
+    m_extraFlip = false;
+    m_skipCount = 0;
+    m_game.resetTurnPointers();
+    m_game.activateAllPlayers();
+}
+
+template <class Geometry>
+void GameEngine<Geometry>::revealInitialCards() {
+    using Ops = MaskOps<Mask>;
+    BasicBoard<Geometry>& board = m_game.board();
+    std::vector<Player>& players = m_game.players();
+    for (std::size_t index = 0; index < players.size(); ++index) {
+        const Mask cells = peek_mask(m_game, index);
+        for (Mask mask = cells; Ops::any(mask); mask = Ops::dropLowest(mask)) {
+            board.turnFaceUpAt(Ops::lowest(mask));
+        }
+        emit(makeEvent(EventType::Peek, index));
+        if (hasAgent(index)) {
+            agentFor(index).peek(m_game, players[index], cells);
+        }
+        for (Mask mask = cells; Ops::any(mask); mask = Ops::dropLowest(mask)) {
+            board.turnFaceDownAt(Ops::lowest(mask));
+        }
+    }
+}
+
+template <class Geometry>
+void GameEngine<Geometry>::awardRubies() {
+    TRACE_SCOPE("award.rubies");
+    std::vector<Player>& players = m_game.players();
+    const std::uint32_t active = m_game.activeMask();
+    if (active == 0) {
+        emit(makeEvent(EventType::NoWinner));
+        return;
+    }
+    const std::size_t winner = count_trailing_zeros(active);
+
+    if (m_rubisDeck.isEmpty()) {
+        m_rubisDeck.reset();
+        m_rubisDeck.shuffle();
+    }
+    const Rubis* prize = m_rubisDeck.getNext();
+    if (prize == nullptr) {
+        emit(makeEvent(EventType::NoRubies, winner));
+        return;
+    }
+    players[winner].addRubis(*prize);
+    GameEvent award = makeEvent(EventType::RubyAwarded, winner);
+    award.value = static_cast<int>(*prize);
+    emit(award);
+}
+
+template <class Geometry>
+bool GameEngine<Geometry>::hasFlippableCard(bool blockActive) const {
+    return MaskOps<Mask>::any(m_game.board().flippableMask(blockActive));
+}
+
+template <class Geometry>
+bool GameEngine<Geometry>::hasAgent(std::size_t playerIndex) const {
+    return playerIndex < m_agents.size() && m_agents[playerIndex] != nullptr;
+}
+
+template <class Geometry>
+BasicAgent<Geometry>& GameEngine<Geometry>::agentFor(std::size_t playerIndex) {
+    if (playerIndex >= m_agents.size() || m_agents[playerIndex] == nullptr) {
+        throw std::logic_error("No agent assigned to player");
+    }
+    return *m_agents[playerIndex];
+}
+
+template <class Geometry>
+GameEvent GameEngine<Geometry>::makeEvent(EventType type, std::size_t player) {
+    GameEvent event;
+    event.type = type;
+    event.player = player;
+    return event;
+}
+
+template <class Geometry>
+GameEvent GameEngine<Geometry>::abilityEvent(EventType type) const {
+    GameEvent event = makeEvent(type, m_turnIndex);
+    event.position = m_abilityOrigin;
+    return event;
+}
+
+template <class Geometry>
+void GameEngine<Geometry>::emit(const GameEvent& event) {
+    for (BasicGameObserver<Geometry>* observer : m_observers) {
+        observer->onEvent(m_game, event);
+    }
+}
+
+template class GameEngine<ClassicGeometry>;
+template class GameEngine<Geometry7x7>;
+template class GameEngine<Geometry9x9>;
@@ -1,7 +1,10 @@
 // Utility helpers that convert between enums, symbols, and board coordinates.
 #include "Enums.h"
 
+#include "CellMasks.h"
+
 #include <array>
+#include <cctype>
 #include <stdexcept>
 
 namespace {
@@ -27,6 +30,10 @@ std::string to_string(Side side) {
     return kSideNames.at(static_cast<std::size_t>(side));
 }
 
+const char* side_name(Side side) {
+    return kSideNames.at(static_cast<std::size_t>(side));
+}
+
 char background_symbol(FaceBackground background) {
     return kBackgroundSymbols.at(static_cast<std::size_t>(background));
 }
@@ -43,6 +50,20 @@ char number_symbol(Number number) {
     return kNumberSymbols.at(static_cast<std::size_t>(number));
 }
 
+bool parse_position(const char* begin, const char* end, Position& position) {
+    if (end - begin != 2) {
+        return false;
+    }
+    const int row = std::toupper(static_cast<unsigned char>(begin[0])) - kLetterSymbols[0];
+    const int column = begin[1] - kNumberSymbols[0];
+    if (row < 0 || row >= static_cast<int>(kLetterSymbols.size()) || column < 0 ||
+        column >= static_cast<int>(kNumberSymbols.size())) {
+        return false;
+    }
+    position = Position{static_cast<Letter>(row), static_cast<Number>(column)};
+    return true;
+}
+
 std::size_t to_index(Letter letter) {
     return static_cast<std::size_t>(letter);
 }
@@ -51,34 +72,8 @@ std::size_t to_index(Number number) {
     return static_cast<std::size_t>(number);
 }
 
-std::vector<Position> orthogonal_neighbours(const Position& origin) {
-    std::vector<Position> neighbours;
-    std::size_t row = to_index(origin.letter);
-    std::size_t col = to_index(origin.number);
-
-    if (row > 0) {
-        neighbours.push_back(Position{static_cast<Letter>(row - 1), origin.number});
-    }
-    if (row + 1 < 5) {
-        neighbours.push_back(Position{static_cast<Letter>(row + 1), origin.number});
-    }
-    if (col > 0) {
-        neighbours.push_back(Position{origin.letter, static_cast<Number>(col - 1)});
-    }
-    if (col + 1 < 5) {
-        neighbours.push_back(Position{origin.letter, static_cast<Number>(col + 1)});
-    }
-    return neighbours;
-}
-
 bool is_adjacent(const Position& lhs, const Position& rhs) {
-    auto neighbours = orthogonal_neighbours(lhs);
-    for (const auto& pos : neighbours) {
-        if (pos == rhs) {
-            return true;
-        }
-    }
-    return false;
+    return (neighbour_mask(cell_index(lhs)) >> cell_index(rhs)) & 1u;
 }
 
 bool operator==(const Position& lhs, const Position& rhs) {
@@ -1,26 +1,45 @@
 // Game implementation: manages board state, players, and printing helpers.
 #include "Game.h"
 
+#include "Renderer.h"
+#include "Seating.h"
+#include "Snapshot.h"
+
 #include <algorithm>
 #include <ostream>
 #include <stdexcept>
 
-Game::Game(DeckFactory<Card>& cardDeck, const GameOptions& options)
-    : m_cardStorage(), m_board(cardDeck, m_cardStorage), m_options(options) {}
+template <class Geometry>
+BasicGame<Geometry>::BasicGame(DeckFactory<BasicCard<Geometry>, Geometry::kCardCount>& cardDeck,
+                               const GameOptions& options)
+    : m_board(cardDeck), m_options(options) {}
 
-int Game::getRound() const {
+template <class Geometry>
+int BasicGame<Geometry>::getRound() const {
     return m_round;
 }
 
-void Game::incrementRound() {
+template <class Geometry>
+void BasicGame<Geometry>::incrementRound() {
     ++m_round;
 }
 
-void Game::addPlayer(const Player& player) {
+template <class Geometry>
+void BasicGame<Geometry>::addPlayer(const Player& player) {
+    if (m_players.size() >= kMaxSeats) {
+        throw std::length_error("Too many players");
+    }
+    if (player.isActive()) {
+        m_activeMask |= 1u << m_players.size();
+    }
     m_players.push_back(player);
 }
 
-Player& Game::getPlayer(Side side) {
+template <class Geometry>
+Player& BasicGame<Geometry>::getPlayer(Side side) {
+    if (m_players.size() > kClassicSeats) {
+        throw std::logic_error("Sides do not identify seats on tables of more than four players");
+    }
     auto it = std::find_if(m_players.begin(), m_players.end(), [side](const Player& p) { return p.getSide() == side; });
     if (it == m_players.end()) {
         throw std::runtime_error("Player with specified side not found");
@@ -28,101 +47,179 @@ Player& Game::getPlayer(Side side) {
     return *it;
 }
 
-const std::vector<Player>& Game::players() const {
+template <class Geometry>
+const std::vector<Player>& BasicGame<Geometry>::players() const {
     return m_players;
 }
 
-std::vector<Player>& Game::players() {
+template <class Geometry>
+std::vector<Player>& BasicGame<Geometry>::players() {
     return m_players;
 }
 
-const Card* Game::getPreviousCard() const {
-    return m_previousCard;
+template <class Geometry>
+const BasicCard<Geometry>* BasicGame<Geometry>::getPreviousCard() const {
+    return m_hasPreviousCard ? &m_previousCard : nullptr;
 }
 
-const Card* Game::getCurrentCard() const {
-    return m_currentCard;
+template <class Geometry>
+const BasicCard<Geometry>* BasicGame<Geometry>::getCurrentCard() const {
+    return m_hasCurrentCard ? &m_currentCard : nullptr;
 }
 
-void Game::setCurrentCard(const Card* card) {
+template <class Geometry>
+void BasicGame<Geometry>::setCurrentCard(const BasicCard<Geometry>& card) {
     m_previousCard = m_currentCard;
+    m_hasPreviousCard = m_hasCurrentCard;
     m_currentCard = card;
+    m_hasCurrentCard = true;
 }
 
-Card* Game::getCard(const Letter& letter, const Number& number) {
+template <class Geometry>
+BasicCard<Geometry> BasicGame<Geometry>::getCard(const Letter& letter, const Number& number) const {
     return m_board.getCard(letter, number);
 }
 
-void Game::setCard(const Letter& letter, const Number& number, Card* card) {
+template <class Geometry>
+void BasicGame<Geometry>::setCard(const Letter& letter, const Number& number, const BasicCard<Geometry>& card) {
     m_board.setCard(letter, number, card);
 }
 
-Board& Game::board() {
+template <class Geometry>
+BasicBoard<Geometry>& BasicGame<Geometry>::board() {
     return m_board;
 }
 
-const Board& Game::board() const {
+template <class Geometry>
+const BasicBoard<Geometry>& BasicGame<Geometry>::board() const {
     return m_board;
 }
 
-DisplayMode Game::displayMode() const {
+template <class Geometry>
+DisplayMode BasicGame<Geometry>::displayMode() const {
     return m_options.displayMode;
 }
 
-RulesMode Game::rulesMode() const {
+template <class Geometry>
+RulesMode BasicGame<Geometry>::rulesMode() const {
     return m_options.rulesMode;
 }
 
-void Game::setCurrentPlayerIndex(std::size_t index) {
+template <class Geometry>
+void BasicGame<Geometry>::setPlayerActive(std::size_t seat, bool active) {
+    m_players.at(seat).setActive(active);
+    if (active) {
+        m_activeMask |= 1u << seat;
+    } else {
+        m_activeMask &= ~(1u << seat);
+    }
+}
+
+template <class Geometry>
+void BasicGame<Geometry>::activateAllPlayers() {
+    for (auto& player : m_players) {
+        player.setActive(true);
+    }
+    m_activeMask = m_players.empty() ? 0u : 0xFFFFFFFFu >> (kMaxSeats - m_players.size());
+}
+
+template <class Geometry>
+std::uint32_t BasicGame<Geometry>::activeMask() const {
+    return m_activeMask;
+}
+
+template <class Geometry>
+std::size_t BasicGame<Geometry>::activeCount() const {
+    return popcount(m_activeMask);
+}
+
+template <class Geometry>
+std::size_t BasicGame<Geometry>::nextActivePlayer(std::size_t seat) const {
+    return next_set_bit_cyclic(m_activeMask, static_cast<unsigned>(seat));
+}
+
+template <class Geometry>
+void BasicGame<Geometry>::setCurrentPlayerIndex(std::size_t index) {
     m_currentPlayer = index;
 }
 
-std::size_t Game::currentPlayerIndex() const {
+template <class Geometry>
+std::size_t BasicGame<Geometry>::currentPlayerIndex() const {
     return m_currentPlayer;
 }
 
-Player& Game::currentPlayer() {
+template <class Geometry>
+Player& BasicGame<Geometry>::currentPlayer() {
     return m_players.at(m_currentPlayer);
 }
 
-void Game::resetTurnPointers() {
-    m_previousCard = nullptr;
-    m_currentCard = nullptr;
+template <class Geometry>
+void BasicGame<Geometry>::resetTurnPointers() {
+    m_hasPreviousCard = false;
+    m_hasCurrentCard = false;
     m_currentPlayer = 0;
 }
 
-// Description: Streams the board view (base or expert) followed by player info.
-// Parameters: os (std::ostream&), game (const Game&).
-// Returns: std::ostream& for chaining.
-std::ostream& operator<<(std::ostream& os, const Game& game) {
-    if (game.m_options.displayMode == DisplayMode::Base) {
-        os << game.m_board;
-    } else {
-        const auto faceUp = game.m_board.faceUpCards();
-        if (faceUp.empty()) {
-            os << "No cards are currently face up." << '\n';
-        } else {
-            for (std::size_t row = 0; row < 3; ++row) {
-                for (std::size_t idx = 0; idx < faceUp.size(); ++idx) {
-                    if (idx > 0) {
-                        os << ' ';
-                    }
-                    os << faceUp[idx].second->operator()(row);
-                }
-                os << '\n';
-            }
-            for (std::size_t idx = 0; idx < faceUp.size(); ++idx) {
-                if (idx > 0) {
-                    os << ' ';
-                }
-                os << letter_symbol(faceUp[idx].first.letter) << number_symbol(faceUp[idx].first.number);
-            }
-            os << '\n';
-        }
+template <>
+void Game::saveState(GameSnapshot& snapshot) const {
+    if (m_players.size() > GameSnapshot::kMaxPlayers) {
+        throw std::invalid_argument("Too many players for a snapshot: it holds at most " +
+                                    std::to_string(GameSnapshot::kMaxPlayers) + " seats");
     }
+    snapshot.cards = m_board.cardIds();
+    snapshot.faceUp = m_board.faceUpMask();
+    snapshot.blocked = m_board.blockedMask();
+    snapshot.previous = m_previousCard.id();
+    snapshot.current = m_currentCard.id();
+    snapshot.flags = static_cast<std::uint8_t>((snapshot.flags & ~(GameSnapshot::kHasPrevious | GameSnapshot::kHasCurrent)) |
+                                               (m_hasPreviousCard ? GameSnapshot::kHasPrevious : 0) |
+                                               (m_hasCurrentCard ? GameSnapshot::kHasCurrent : 0));
+    snapshot.round = static_cast<std::uint8_t>(m_round);
+    snapshot.playerCount = static_cast<std::uint8_t>(m_players.size());
+    snapshot.currentPlayer = static_cast<std::uint8_t>(m_currentPlayer);
+    snapshot.activeMask = static_cast<std::uint8_t>(m_activeMask);
+    snapshot.endOfGameMask = 0;
+    snapshot.sides = 0;
+    snapshot.rubies.fill(0);
+    for (std::size_t seat = 0; seat < m_players.size(); ++seat) {
+        const Player& player = m_players[seat];
+        snapshot.endOfGameMask |= static_cast<std::uint8_t>((player.displaysRubies() ? 1u : 0u) << seat);
+        snapshot.sides |= static_cast<std::uint8_t>(static_cast<unsigned>(player.getSide()) << (seat * 2));
+        snapshot.rubies[seat] = static_cast<std::uint8_t>(player.getNRubies());
+    }
+}
 
-    for (const auto& player : game.m_players) {
-        os << player << '\n';
+template <>
+void Game::restoreState(const GameSnapshot& snapshot) {
+    if (!is_valid(snapshot) || snapshot.playerCount != m_players.size()) {
+        throw std::invalid_argument("Snapshot does not match this game");
     }
+    m_board.restoreState(snapshot.cards, snapshot.faceUp, snapshot.blocked);
+    m_previousCard = Card::fromIdUnchecked(snapshot.previous);
+    m_currentCard = Card::fromIdUnchecked(snapshot.current);
+    m_hasPreviousCard = (snapshot.flags & GameSnapshot::kHasPrevious) != 0;
+    m_hasCurrentCard = (snapshot.flags & GameSnapshot::kHasCurrent) != 0;
+    m_round = snapshot.round;
+    m_currentPlayer = snapshot.currentPlayer;
+    m_activeMask = m_players.empty() ? 0u : snapshot.activeMask & (0xFFFFFFFFu >> (kMaxSeats - m_players.size()));
+    for (std::size_t seat = 0; seat < m_players.size(); ++seat) {
+        Player& player = m_players[seat];
+        player.setActive((snapshot.activeMask >> seat) & 1u);
+        player.setDisplayMode((snapshot.endOfGameMask >> seat) & 1u);
+        player.setSide(static_cast<Side>((snapshot.sides >> (seat * 2)) & 3u));
+        player.setNRubies(snapshot.rubies[seat]);
+    }
+}
+
+template class BasicGame<ClassicGeometry>;
+template class BasicGame<Geometry7x7>;
+template class BasicGame<Geometry9x9>;
+
+// Description: Streams the board view (base or expert) followed by player info as one frame.
+// Parameters: os (std::ostream&), game (const Game&).
+// Returns: std::ostream& for chaining.
+std::ostream& operator<<(std::ostream& os, const Game& game) {
+    FrameWriter frame(os);
+    frame.appendGame(game);
     return os;
 }
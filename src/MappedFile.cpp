@@ -0,0 +1,68 @@
+// MappedFile implementation: mmap on POSIX, whole-file read elsewhere.
+#include "MappedFile.h"
+
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MEMOARRR_HAS_MMAP 1
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+#ifdef MEMOARRR_HAS_MMAP
+MappedFile::MappedFile(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot stat " + path);
+    }
+    m_size = static_cast<std::size_t>(info.st_size);
+    if (m_size > 0) {
+        void* mapping = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Cannot map " + path);
+        }
+        // Replays scan front to back.
+        ::madvise(mapping, m_size, MADV_SEQUENTIAL);
+        m_data = static_cast<const std::uint8_t*>(mapping);
+        m_mapped = true;
+    }
+    ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (m_mapped) {
+        ::munmap(const_cast<std::uint8_t*>(m_data), m_size);
+    }
+}
+#else
+MappedFile::MappedFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    m_buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    m_data = m_buffer.empty() ? nullptr : m_buffer.data();
+    m_size = m_buffer.size();
+}
+
+MappedFile::~MappedFile() = default;
+#endif
+
+const std::uint8_t* MappedFile::data() const {
+    return m_data;
+}
+
+std::size_t MappedFile::size() const {
+    return m_size;
+}
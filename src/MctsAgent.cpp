@@ -0,0 +1,474 @@
+// MctsAgent implementation: determinized round simulator plus parallel root-level tree search.
+#include "MctsAgent.h"
+
+#include "Game.h"
+#include "Rules.h"
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+namespace {
+// Action encoding: kind in the high bits, cell index (0-24) in the low five bits.
+enum ActionKind : std::uint16_t { kFlip = 0, kSwap = 1, kFlipDown = 2, kBlock = 3, kSkip = 4 };
+constexpr std::size_t kActionSpace = 5 * 32;
+// Largest number of legal actions in any phase (24 cells plus skip).
+constexpr std::size_t kMaxActions = 32;
+
+std::uint16_t make_action(std::uint16_t kind, std::size_t cell = 0) {
+    return static_cast<std::uint16_t>((kind << 5) | cell);
+}
+std::uint16_t action_kind(std::uint16_t action) {
+    return static_cast<std::uint16_t>(action >> 5);
+}
+std::size_t action_cell(std::uint16_t action) {
+    return action & 31u;
+}
+
+// Search tree node; children form a singly linked list through nextSibling.
+struct Node {
+    std::uint16_t action{0};
+    std::uint8_t actor{0};
+    std::uint32_t firstChild{0};
+    std::uint32_t nextSibling{0};
+    std::uint32_t visits{0};
+    std::uint32_t avails{0};
+    float wins{0.0f};
+};
+}
+
+// Compact copy of everything that decides the rest of a round. Mirrors the turn state machine in
+// BasicEngine.h (Engine::stepWith, flipWith and startAbility) so that a round can be replayed
+// thousands of times per decision; changes to those phases must be tracked here.
+struct MctsAgent::SearchState {
+    enum class Phase : std::uint8_t { Flip, Octopus, Penguin, Walrus, RoundOver };
+
+    Board board;
+    Card previous;
+    Card current;
+    bool hasPrevious;
+    bool hasCurrent;
+    bool expert;
+    bool blockActive;
+    bool walrusPending;
+    bool extraFlip;
+    std::uint8_t skipCount;
+    std::uint8_t players;
+    std::uint8_t toMove;
+    std::uint8_t origin;
+    std::uint32_t active;
+    Phase phase;
+
+    // Returns: number of legal actions written to out.
+    std::size_t legalActions(std::uint16_t* out) const {
+        std::size_t count = 0;
+        auto addCells = [&](std::uint16_t kind, std::uint32_t mask) {
+            for (; mask != 0; mask &= mask - 1) {
+                out[count++] = make_action(kind, count_trailing_zeros(mask));
+            }
+        };
+        switch (phase) {
+        case Phase::Flip:
+            addCells(kFlip, board.flippableMask(blockActive && board.flippableMask(true) != 0));
+            break;
+        case Phase::Octopus:
+            addCells(kSwap, neighbour_mask(origin) & board.occupiedMask());
+            break;
+        case Phase::Penguin:
+            addCells(kFlipDown, board.faceUpMask() & ~(1u << origin));
+            out[count++] = make_action(kSkip);
+            break;
+        case Phase::Walrus:
+            addCells(kBlock, board.faceDownMask());
+            out[count++] = make_action(kSkip);
+            break;
+        case Phase::RoundOver:
+            break;
+        }
+        return count;
+    }
+
+    void apply(std::uint16_t action) {
+        const std::size_t cell = action_cell(action);
+        switch (action_kind(action)) {
+        case kFlip:
+            flip(cell);
+            return;
+        case kSwap:
+            board.swapCellsAt(origin, cell);
+            break;
+        case kFlipDown:
+            board.turnFaceDownAt(cell);
+            break;
+        case kBlock:
+            board.blockOnlyAt(cell);
+            walrusPending = true;
+            break;
+        default:
+            break;
+        }
+        continueTurn();
+    }
+
+    // Returns: index of the round winner, or -1 when nobody survived.
+    int winner() const {
+        return active == 0 ? -1 : static_cast<int>(count_trailing_zeros(active));
+    }
+
+private:
+    void flip(std::size_t cell) {
+        board.turnFaceUpAt(cell);
+        previous = current;
+        hasPrevious = hasCurrent;
+        current = board.cardAt(cell);
+        hasCurrent = true;
+        if (blockActive) {
+            board.clearBlocked();
+            blockActive = false;
+        }
+        if (hasPrevious && !Rules::matches(previous, current)) {
+            active &= ~(1u << toMove);
+            extraFlip = false;
+            endTurn();
+            return;
+        }
+        if (expert) {
+            switch (static_cast<FaceAnimal>(current)) {
+            case FaceAnimal::Octopus:
+                if (neighbour_mask(cell) & board.occupiedMask()) {
+                    phase = Phase::Octopus;
+                    origin = static_cast<std::uint8_t>(cell);
+                    return;
+                }
+                break;
+            case FaceAnimal::Penguin:
+                if (hasPrevious && (board.faceUpMask() & ~(1u << cell))) {
+                    phase = Phase::Penguin;
+                    origin = static_cast<std::uint8_t>(cell);
+                    return;
+                }
+                break;
+            case FaceAnimal::Walrus:
+                phase = Phase::Walrus;
+                return;
+            case FaceAnimal::Crab:
+                extraFlip = true;
+                break;
+            case FaceAnimal::Turtle:
+                ++skipCount;
+                break;
+            }
+        }
+        continueTurn();
+    }
+
+    void continueTurn() {
+        if (extraFlip && ((active >> toMove) & 1u) && board.hasFaceDownCards()) {
+            extraFlip = false;
+            phase = Phase::Flip;
+            return;
+        }
+        extraFlip = false;
+        endTurn();
+    }
+
+    void endTurn() {
+        while (popcount(active) > 1) {
+            toMove = static_cast<std::uint8_t>(next_set_bit_cyclic(active, toMove));
+            if (skipCount > 0) {
+                --skipCount;
+                continue;
+            }
+            if (!board.hasFaceDownCards()) {
+                active &= ~(1u << toMove);
+                continue;
+            }
+            if (walrusPending) {
+                blockActive = true;
+                walrusPending = false;
+            }
+            phase = Phase::Flip;
+            return;
+        }
+        phase = Phase::RoundOver;
+    }
+};
+
+namespace {
+// Description: Replaces every card the agent has not seen with a random assignment of the unseen ids.
+// Parameters: state (SearchState&), known (cell mask of trusted cards), rng (Xoshiro256&).
+template <typename State>
+void determinize(State& state, std::uint32_t known, Xoshiro256& rng) {
+    const std::uint32_t occupied = state.board.occupiedMask();
+    std::uint32_t seenIds = 0;
+    for (std::uint32_t mask = occupied & known; mask != 0; mask &= mask - 1) {
+        seenIds |= 1u << state.board.cardAt(count_trailing_zeros(mask)).id();
+    }
+    CardId pool[Card::kCount];
+    std::size_t poolSize = 0;
+    for (std::size_t id = 0; id < Card::kCount; ++id) {
+        if (!((seenIds >> id) & 1u)) {
+            pool[poolSize++] = static_cast<CardId>(id);
+        }
+    }
+    for (std::uint32_t mask = occupied & ~known; mask != 0; mask &= mask - 1) {
+        const std::size_t pick = rng.bounded(static_cast<std::uint32_t>(poolSize));
+        state.board.setCardAt(count_trailing_zeros(mask), Card::fromIdUnchecked(pool[pick]));
+        pool[pick] = pool[--poolSize];
+    }
+}
+
+// Description: Grows one information-set search tree and accumulates root visit counts.
+// Parameters: root state, known cell mask, iteration/time budget, exploration constant, seed, visits (out).
+template <typename State>
+void grow_tree(const State& root, std::uint32_t known, std::size_t iterations,
+               std::chrono::steady_clock::time_point deadline, bool timed, double exploration, std::uint64_t seed,
+               std::vector<std::uint32_t>& rootVisits) {
+    Xoshiro256 rng(seed);
+    std::vector<Node> nodes(1);
+    std::vector<std::uint32_t> path;
+    std::uint16_t actions[kMaxActions];
+
+    for (std::size_t iteration = 0; iterations == 0 || iteration < iterations; ++iteration) {
+        if (timed && (iteration & 63) == 0 && std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+        State state = root;
+        determinize(state, known, rng);
+        path.clear();
+        path.push_back(0);
+        std::uint32_t node = 0;
+
+        // Selection and expansion.
+        while (state.phase != State::Phase::RoundOver) {
+            const std::size_t count = state.legalActions(actions);
+            std::uint32_t tried = 0;
+            std::uint32_t best = 0;
+            double bestScore = -1.0;
+            for (std::uint32_t child = nodes[node].firstChild; child != 0; child = nodes[child].nextSibling) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    if (actions[i] == nodes[child].action) {
+                        tried |= 1u << i;
+                        ++nodes[child].avails;
+                        const double score = nodes[child].wins / nodes[child].visits +
+                                             exploration * std::sqrt(std::log(static_cast<double>(nodes[child].avails)) /
+                                                                     nodes[child].visits);
+                        if (score > bestScore) {
+                            bestScore = score;
+                            best = child;
+                        }
+                        break;
+                    }
+                }
+            }
+            const std::uint32_t untried = static_cast<std::uint32_t>((std::uint64_t{1} << count) - 1) & ~tried;
+            if (untried != 0) {
+                const std::uint16_t action = actions[nth_set_bit(untried, rng.bounded(popcount(untried)))];
+                Node expanded;
+                expanded.action = action;
+                expanded.actor = state.toMove;
+                expanded.avails = 1;
+                expanded.nextSibling = nodes[node].firstChild;
+                nodes.push_back(expanded);
+                const std::uint32_t child = static_cast<std::uint32_t>(nodes.size() - 1);
+                nodes[node].firstChild = child;
+                state.apply(action);
+                path.push_back(child);
+                break;
+            }
+            state.apply(nodes[best].action);
+            node = best;
+            path.push_back(node);
+        }
+
+        // Random playout to the end of the round.
+        while (state.phase != State::Phase::RoundOver) {
+            const std::size_t count = state.legalActions(actions);
+            state.apply(actions[rng.bounded(static_cast<std::uint32_t>(count))]);
+        }
+
+        const int winner = state.winner();
+        for (std::uint32_t index : path) {
+            ++nodes[index].visits;
+            if (index != 0 && nodes[index].actor == winner) {
+                nodes[index].wins += 1.0f;
+            }
+        }
+    }
+
+    for (std::uint32_t child = nodes[0].firstChild; child != 0; child = nodes[child].nextSibling) {
+        rootVisits[nodes[child].action] += nodes[child].visits;
+    }
+}
+}
+
+MctsAgent::MctsAgent(std::uint64_t seed, const MctsConfig& config) : m_config(config), m_rng(seed) {
+    if (m_config.threads > 1) {
+        m_pool.reset(new WorkStealingPool(m_config.threads));
+    }
+}
+
+MctsAgent::~MctsAgent() = default;
+
+void MctsAgent::peek(const Game& game, const Player&, std::uint32_t cells) {
+    for (; cells != 0; cells &= cells - 1) {
+        const std::size_t index = count_trailing_zeros(cells);
+        m_knowledge.learn(index, game.board().cardAt(index).id());
+    }
+}
+
+Position MctsAgent::chooseFlip(const Game& game, const Player& player, bool blockActive) {
+    SearchState root = rootState(game, player);
+    root.blockActive = blockActive;
+    root.phase = SearchState::Phase::Flip;
+    return Board::positionOf(action_cell(search(root)));
+}
+
+Position MctsAgent::chooseOctopusTarget(const Game& game, const Player& player, const Position& origin,
+                                        const std::vector<Position>& options) {
+    SearchState root = rootState(game, player);
+    root.phase = SearchState::Phase::Octopus;
+    root.origin = static_cast<std::uint8_t>(Board::indexOf(origin));
+    const Position choice = Board::positionOf(action_cell(search(root)));
+    for (const auto& option : options) {
+        if (option == choice) {
+            return choice;
+        }
+    }
+    return options.front();
+}
+
+bool MctsAgent::choosePenguinTarget(const Game& game, const Player& player, const std::vector<Position>& options,
+                                    Position& target) {
+    SearchState root = rootState(game, player);
+    root.phase = SearchState::Phase::Penguin;
+    // The penguin's own cell is the one face-up card missing from options (the empty centre otherwise).
+    std::uint32_t eligible = 0;
+    for (const auto& option : options) {
+        eligible |= 1u << Board::indexOf(option);
+    }
+    const std::uint32_t excluded = game.board().faceUpMask() & ~eligible;
+    root.origin = static_cast<std::uint8_t>(
+        excluded != 0 ? count_trailing_zeros(excluded) : Board::indexOf(Position{Letter::C, Number::Three}));
+    const std::uint16_t action = search(root);
+    if (action_kind(action) != kFlipDown) {
+        return false;
+    }
+    target = Board::positionOf(action_cell(action));
+    return true;
+}
+
+bool MctsAgent::chooseWalrusBlock(const Game& game, const Player& player, Position& target) {
+    SearchState root = rootState(game, player);
+    root.phase = SearchState::Phase::Walrus;
+    const std::uint16_t action = search(root);
+    if (action_kind(action) != kBlock) {
+        return false;
+    }
+    target = Board::positionOf(action_cell(action));
+    return true;
+}
+
+void MctsAgent::onEvent(const Game& game, const GameEvent& event) {
+    m_knowledge.observe(game, event);
+    switch (event.type) {
+    case EventType::RoundStart:
+        m_skipCount = 0;
+        m_walrusPending = false;
+        break;
+    case EventType::TurtleSkip:
+        ++m_skipCount;
+        break;
+    case EventType::Skipped:
+        --m_skipCount;
+        break;
+    case EventType::WalrusBlock:
+        m_walrusPending = true;
+        break;
+    case EventType::BlockEnforced:
+        m_walrusPending = false;
+        break;
+    default:
+        break;
+    }
+}
+
+MctsAgent::SearchState MctsAgent::rootState(const Game& game, const Player& player) const {
+    const auto& players = game.players();
+    SearchState state{game.board(),
+                      game.getPreviousCard() ? *game.getPreviousCard() : Card::fromId(0),
+                      game.getCurrentCard() ? *game.getCurrentCard() : Card::fromId(0),
+                      game.getPreviousCard() != nullptr,
+                      game.getCurrentCard() != nullptr,
+                      game.rulesMode() == RulesMode::Expert,
+                      false,
+                      m_walrusPending,
+                      false,
+                      static_cast<std::uint8_t>(m_skipCount),
+                      static_cast<std::uint8_t>(players.size()),
+                      0,
+                      0,
+                      0,
+                      SearchState::Phase::Flip};
+    for (std::size_t index = 0; index < players.size(); ++index) {
+        if (&players[index] == &player) {
+            state.toMove = static_cast<std::uint8_t>(index);
+        }
+    }
+    state.active = game.activeMask();
+    return state;
+}
+
+std::uint16_t MctsAgent::search(const SearchState& root) {
+    // Cards we remember plus everything currently face up are trusted; the rest is resampled.
+    const std::uint32_t known = m_knowledge.known | root.board.faceUpMask();
+    SearchState trusted = root;
+    for (std::uint32_t mask = m_knowledge.known & ~root.board.faceUpMask(); mask != 0; mask &= mask - 1) {
+        const unsigned index = count_trailing_zeros(mask);
+        trusted.board.setCardAt(index, Card::fromIdUnchecked(m_knowledge.cards[index]));
+    }
+
+    std::uint16_t actions[kMaxActions];
+    const std::size_t count = trusted.legalActions(actions);
+    if (count == 1) {
+        return actions[0];
+    }
+
+    const std::size_t trees = m_pool ? m_pool->size() : 1;
+    const bool timed = m_config.seconds > 0.0;
+    const auto deadline =
+        std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(m_config.seconds));
+    std::size_t perTree = m_config.iterations == 0 ? 0 : (m_config.iterations + trees - 1) / trees;
+    if (perTree == 0 && !timed) {
+        perTree = 1;
+    }
+
+    std::vector<std::uint64_t> seeds(trees);
+    for (auto& seed : seeds) {
+        seed = m_rng();
+    }
+    std::vector<std::vector<std::uint32_t>> visits(trees, std::vector<std::uint32_t>(kActionSpace, 0));
+    auto runTree = [&](std::size_t tree, std::size_t) {
+        grow_tree(trusted, known, perTree, deadline, timed, m_config.exploration, seeds[tree], visits[tree]);
+    };
+    if (m_pool) {
+        m_pool->parallelFor(trees, runTree);
+    } else {
+        runTree(0, 0);
+    }
+
+    std::uint16_t best = actions[0];
+    std::uint64_t bestVisits = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint64_t total = 0;
+        for (const auto& tree : visits) {
+            total += tree[actions[i]];
+        }
+        if (total > bestVisits) {
+            bestVisits = total;
+            best = actions[i];
+        }
+    }
+    return best;
+}
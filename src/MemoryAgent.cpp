@@ -0,0 +1,169 @@
+// MemoryAgent implementation: mask-based decisions over remembered card positions.
+#include "MemoryAgent.h"
+
+#include "Game.h"
+#include "RandomAgent.h"
+
+#include <stdexcept>
+
+namespace {
+// Per card id, the set of card ids (one bit per id of the geometry's alphabet) sharing its animal or
+// its background.
+template <class Geometry>
+struct MatchTable {
+    using IdMask = CellMask<Geometry::kCardCount>;
+
+    IdMask ids[Geometry::kCardCount];
+};
+
+// Description: Builds the card-id match table of a geometry at compile time.
+// Returns: MatchTable<Geometry> where bit j of ids[i] is set when cards i and j match.
+template <class Geometry>
+constexpr MatchTable<Geometry> make_match_table() {
+    using IdOps = MaskOps<typename MatchTable<Geometry>::IdMask>;
+    MatchTable<Geometry> table{};
+    for (std::size_t i = 0; i < Geometry::kCardCount; ++i) {
+        for (std::size_t j = 0; j < Geometry::kCardCount; ++j) {
+            if (Geometry::matches(static_cast<CardId>(i), static_cast<CardId>(j))) {
+                table.ids[i] = table.ids[i] | IdOps::bit(j);
+            }
+        }
+    }
+    return table;
+}
+
+// One shared match table per geometry.
+template <class Geometry>
+struct MatchTables {
+    static constexpr MatchTable<Geometry> kMatches = make_match_table<Geometry>();
+};
+
+template <class Geometry>
+constexpr MatchTable<Geometry> MatchTables<Geometry>::kMatches;
+}
+
+template <class Geometry>
+void GridKnowledge<Geometry>::observe(const BasicGame<Geometry>& game, const GameEvent& event) {
+    switch (event.type) {
+    case EventType::GameStart:
+        *this = GridKnowledge();
+        break;
+    case EventType::Flip: {
+        const std::size_t index = BasicBoard<Geometry>::indexOf(event.position);
+        learn(index, game.board().cardAt(index).id());
+        break;
+    }
+    case EventType::OctopusSwap:
+        swap(BasicBoard<Geometry>::indexOf(event.position), BasicBoard<Geometry>::indexOf(event.target));
+        break;
+    default:
+        break;
+    }
+}
+
+template <class Geometry>
+BasicMemoryAgent<Geometry>::BasicMemoryAgent(std::uint64_t seed) : m_rng(seed) {}
+
+template <class Geometry>
+void BasicMemoryAgent<Geometry>::peek(const BasicGame<Geometry>& game, const Player&, Mask cells) {
+    using Ops = MaskOps<Mask>;
+    for (; Ops::any(cells); cells = Ops::dropLowest(cells)) {
+        const std::size_t index = Ops::lowest(cells);
+        m_knowledge.learn(index, game.board().cardAt(index).id());
+    }
+}
+
+template <class Geometry>
+Position BasicMemoryAgent<Geometry>::chooseFlip(const BasicGame<Geometry>& game, const Player&, bool blockActive) {
+    using Ops = MaskOps<Mask>;
+    const Mask candidates = game.board().flippableMask(blockActive);
+    if (!Ops::any(candidates)) {
+        throw std::logic_error("No face-down card available");
+    }
+    if (game.getCurrentCard() == nullptr) {
+        // Opening flip of a round: every card is valid.
+        return BasicBoard<Geometry>::positionOf(pick(candidates));
+    }
+    const Mask matches = knownMatches(game, candidates);
+    if (Ops::any(matches)) {
+        return BasicBoard<Geometry>::positionOf(pick(matches));
+    }
+    const Mask unknown = candidates & ~m_knowledge.known;
+    return BasicBoard<Geometry>::positionOf(pick(Ops::any(unknown) ? unknown : candidates));
+}
+
+template <class Geometry>
+Position BasicMemoryAgent<Geometry>::chooseOctopusTarget(const BasicGame<Geometry>& game, const Player&,
+                                                         const Position&, const std::vector<Position>& options) {
+    // Prefer moving a remembered face-down card: it stays known wherever it lands.
+    const Mask preferred = game.board().faceDownMask() & m_knowledge.known;
+    for (const auto& option : options) {
+        if (MaskOps<Mask>::test(preferred, BasicBoard<Geometry>::indexOf(option))) {
+            return option;
+        }
+    }
+    return options[m_rng.bounded(static_cast<std::uint32_t>(options.size()))];
+}
+
+template <class Geometry>
+bool BasicMemoryAgent<Geometry>::choosePenguinTarget(const BasicGame<Geometry>&, const Player&,
+                                                     const std::vector<Position>&, Position&) {
+    // Turning a card back down only gives the following players more safe choices.
+    return false;
+}
+
+template <class Geometry>
+bool BasicMemoryAgent<Geometry>::chooseWalrusBlock(const BasicGame<Geometry>& game, const Player&, Position& target) {
+    using Ops = MaskOps<Mask>;
+    const Mask faceDown = game.board().faceDownMask();
+    if (!Ops::any(faceDown)) {
+        return false;
+    }
+    // The next player must match the walrus: deny them a match we know about.
+    const Mask matches = knownMatches(game, faceDown);
+    target = BasicBoard<Geometry>::positionOf(pick(Ops::any(matches) ? matches : faceDown));
+    return true;
+}
+
+template <class Geometry>
+void BasicMemoryAgent<Geometry>::onEvent(const BasicGame<Geometry>& game, const GameEvent& event) {
+    m_knowledge.observe(game, event);
+}
+
+template <class Geometry>
+const GridKnowledge<Geometry>& BasicMemoryAgent<Geometry>::knowledge() const {
+    return m_knowledge;
+}
+
+template <class Geometry>
+typename BasicMemoryAgent<Geometry>::Mask BasicMemoryAgent<Geometry>::knownMatches(const BasicGame<Geometry>& game,
+                                                                                    const Mask& candidates) const {
+    using Ops = MaskOps<Mask>;
+    using IdMask = typename MatchTable<Geometry>::IdMask;
+    const BasicCard<Geometry>* current = game.getCurrentCard();
+    Mask known = candidates & m_knowledge.known;
+    if (current == nullptr) {
+        return known;
+    }
+    const IdMask& matchingIds = MatchTables<Geometry>::kMatches.ids[current->id()];
+    Mask result{};
+    for (; Ops::any(known); known = Ops::dropLowest(known)) {
+        const unsigned index = Ops::lowest(known);
+        if (MaskOps<IdMask>::test(matchingIds, m_knowledge.cards[index])) {
+            result = result | Ops::bit(index);
+        }
+    }
+    return result;
+}
+
+template <class Geometry>
+std::size_t BasicMemoryAgent<Geometry>::pick(const Mask& mask) {
+    return random_cell(mask, m_rng);
+}
+
+template struct GridKnowledge<ClassicGeometry>;
+template struct GridKnowledge<Geometry7x7>;
+template struct GridKnowledge<Geometry9x9>;
+template class BasicMemoryAgent<ClassicGeometry>;
+template class BasicMemoryAgent<Geometry7x7>;
+template class BasicMemoryAgent<Geometry9x9>;
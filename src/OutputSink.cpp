@@ -0,0 +1,239 @@
+// OutputSink implementation: leveled console messages, the silent sink and packed event records.
+#include "OutputSink.h"
+
+#include "Game.h"
+
+#include <algorithm>
+#include <ostream>
+
+namespace {
+// Description: Gives the least verbose level at which an event is reported.
+// Parameters: type (EventType).
+// Returns: Verbosity threshold (Silent for events that never print).
+Verbosity level_of(EventType type) {
+    switch (type) {
+    case EventType::GameStart:
+    case EventType::Peek:
+        return Verbosity::Silent;
+    case EventType::GameEnd:
+        return Verbosity::Results;
+    case EventType::RoundStart:
+    case EventType::RubyAwarded:
+    case EventType::NoRubies:
+    case EventType::NoWinner:
+    case EventType::RoundEnd:
+        return Verbosity::Rounds;
+    case EventType::Flip:
+        return Verbosity::Boards;
+    default:
+        return Verbosity::Turns;
+    }
+}
+
+// Level names indexed by Verbosity.
+constexpr const char* kVerbosityNames[] = {"silent", "results", "rounds", "turns", "boards"};
+}
+
+bool parse_verbosity(const std::string& text, Verbosity& verbosity) {
+    for (std::size_t level = 0; level < sizeof(kVerbosityNames) / sizeof(kVerbosityNames[0]); ++level) {
+        if (text == kVerbosityNames[level]) {
+            verbosity = static_cast<Verbosity>(level);
+            return true;
+        }
+    }
+    return false;
+}
+
+ConsoleSink::ConsoleSink(std::ostream& os, Verbosity verbosity) : m_os(os), m_verbosity(verbosity), m_frame(os) {}
+
+void ConsoleSink::onEvent(const Game& game, const GameEvent& event) {
+    const Verbosity level = level_of(event.type);
+    if (level == Verbosity::Silent || level > m_verbosity) {
+        return;
+    }
+    const auto& players = game.players();
+    const std::string empty;
+    const std::string& name = event.player < players.size() ? players[event.player].getName() : empty;
+    switch (event.type) {
+    case EventType::GameStart:
+    case EventType::Peek:
+        break;
+    case EventType::RoundStart:
+        m_frame.appendText("\n=== Round ");
+        m_frame.appendNumber(event.value);
+        m_frame.appendText(" ===\n");
+        break;
+    case EventType::Skipped:
+        m_frame.appendText(name);
+        m_frame.appendText(" is skipped due to the turtle effect.\n");
+        break;
+    case EventType::NoCardsLeft:
+        m_frame.appendText(name);
+        m_frame.appendText(" has no cards to flip and is eliminated.\n");
+        break;
+    case EventType::BlockEnforced:
+        m_frame.appendText(name);
+        m_frame.appendText(" must avoid the blocked card.\n");
+        break;
+    case EventType::Flip:
+        m_frame.appendGame(game);
+        break;
+    case EventType::Mismatch:
+        m_frame.appendText(name);
+        m_frame.appendText(" revealed a mismatch and is out of this round.\n");
+        break;
+    case EventType::OctopusSwap:
+        m_frame.appendText("Swapped ");
+        appendPosition(event.position);
+        m_frame.appendText(" with ");
+        appendPosition(event.target);
+        m_frame.appendText(".\n");
+        break;
+    case EventType::OctopusNoTarget:
+        m_frame.appendText("No valid adjacent cards for octopus to swap.\n");
+        break;
+    case EventType::PenguinFlipDown:
+        m_frame.appendText("Card ");
+        appendPosition(event.target);
+        m_frame.appendText(" turned face down.\n");
+        break;
+    case EventType::PenguinSkipped:
+        m_frame.appendText("Penguin action skipped.\n");
+        break;
+    case EventType::PenguinNoPrevious:
+        m_frame.appendText("Penguin ability requires a previous card; no action taken.\n");
+        break;
+    case EventType::PenguinNoTarget:
+        m_frame.appendText("No other face-up cards to flip down.\n");
+        break;
+    case EventType::WalrusBlock:
+        m_frame.appendText("Blocked ");
+        appendPosition(event.target);
+        m_frame.appendText(" for the next player.\n");
+        break;
+    case EventType::WalrusSkipped:
+        m_frame.appendText("No card blocked.\n");
+        break;
+    case EventType::CrabExtraFlip:
+        m_frame.appendText("Crab ability: flip another card immediately.\n");
+        break;
+    case EventType::TurtleSkip:
+        m_frame.appendText("Turtle ability: the next player will be skipped.\n");
+        break;
+    case EventType::RubyAwarded:
+        m_frame.appendText(name);
+        m_frame.appendText(" receives ");
+        appendRubies(event.value);
+        m_frame.appendText("!\n");
+        break;
+    case EventType::NoRubies:
+        m_frame.appendText("No rubies left to award.\n");
+        break;
+    case EventType::NoWinner:
+        m_frame.appendText("No active players remained to claim rubies.\n");
+        break;
+    case EventType::RoundEnd:
+        appendStandings(players);
+        break;
+    case EventType::GameEnd:
+        m_frame.appendText("\n=== Final Results ===\n");
+        for (const auto& player : players) {
+            m_frame.appendPlayer(player);
+            m_frame.appendText("\n");
+        }
+        appendStandings(players);
+        appendWinners(players);
+        break;
+    }
+    m_frame.flush();
+    if (event.type == EventType::GameEnd) {
+        m_os.flush();
+    }
+}
+
+void ConsoleSink::appendPosition(const Position& position) {
+    const char text[3] = {letter_symbol(position.letter), number_symbol(position.number), '\0'};
+    m_frame.appendText(text);
+}
+
+void ConsoleSink::appendRubies(int rubies) {
+    m_frame.appendNumber(rubies);
+    m_frame.appendText(rubies == 1 ? " ruby" : " rubies");
+}
+
+void ConsoleSink::appendStandings(const std::vector<Player>& players) {
+    m_order.clear();
+    for (const auto& player : players) {
+        m_order.push_back(&player);
+    }
+    std::sort(m_order.begin(), m_order.end(), [](const Player* lhs, const Player* rhs) {
+        if (lhs->getNRubies() == rhs->getNRubies()) {
+            return lhs->getName() < rhs->getName();
+        }
+        return lhs->getNRubies() < rhs->getNRubies();
+    });
+    m_frame.appendText("Rubies standings (least to most):\n");
+    for (const Player* player : m_order) {
+        m_frame.appendText("  ");
+        m_frame.appendText(player->getName());
+        m_frame.appendText(": ");
+        appendRubies(player->getNRubies());
+        m_frame.appendText("\n");
+    }
+}
+
+void ConsoleSink::appendWinners(const std::vector<Player>& players) {
+    int best = 0;
+    std::size_t winners = 0;
+    for (const auto& player : players) {
+        best = std::max(best, player.getNRubies());
+    }
+    for (const auto& player : players) {
+        winners += player.getNRubies() == best ? 1 : 0;
+    }
+    if (winners == 0) {
+        m_frame.appendText("No winner could be determined.\n");
+        return;
+    }
+    m_frame.appendText(winners == 1 ? "Overall winner: " : "Overall winners (tie):\n");
+    for (const auto& player : players) {
+        if (player.getNRubies() != best) {
+            continue;
+        }
+        if (winners > 1) {
+            m_frame.appendText("  ");
+        }
+        m_frame.appendText(player.getName());
+        m_frame.appendText(" with ");
+        appendRubies(best);
+        m_frame.appendText(winners == 1 ? ".\n" : "\n");
+    }
+}
+
+BinarySink::BinarySink(std::ostream& os) : m_os(os) {}
+
+BinarySink::~BinarySink() {
+    flush();
+}
+
+void BinarySink::onEvent(const Game&, const GameEvent& event) {
+    m_records[m_count++] = to_record(event);
+    if (m_count == m_records.size() || event.type == EventType::GameEnd) {
+        flush();
+    }
+}
+
+void BinarySink::flush() {
+    if (m_count > 0) {
+        m_os.write(reinterpret_cast<const char*>(m_records.data()),
+                   static_cast<std::streamsize>(m_count * sizeof(ReplayRecord)));
+        m_count = 0;
+    }
+}
+
+std::unique_ptr<GameObserver> make_console_sink(std::ostream& os, Verbosity verbosity) {
+    if (verbosity == Verbosity::Silent) {
+        return std::unique_ptr<GameObserver>(new SilentSink());
+    }
+    return std::unique_ptr<GameObserver>(new ConsoleSink(os, verbosity));
+}
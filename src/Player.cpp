@@ -27,10 +27,18 @@ void Player::addRubis(const Rubis& rubis) {
     m_rubies += static_cast<int>(rubis);
 }
 
+void Player::setNRubies(int rubies) {
+    m_rubies = rubies;
+}
+
 void Player::setDisplayMode(bool endOfGame) {
     m_endOfGame = endOfGame;
 }
 
+bool Player::displaysRubies() const {
+    return m_endOfGame;
+}
+
 Side Player::getSide() const {
     return m_side;
 }
@@ -0,0 +1,293 @@
+// Protocol implementation: one-line text encodings shared by the machine-facing front ends.
+#include "Protocol.h"
+
+#include "Board.h"
+#include "Game.h"
+#include "Seating.h"
+
+#include <array>
+#include <sstream>
+
+namespace {
+// Protocol names indexed by EventType.
+constexpr std::array<const char*, 23> kEventNames{
+    "game-start",
+    "round-start",
+    "peek",
+    "skipped",
+    "no-cards-left",
+    "block-enforced",
+    "flip",
+    "mismatch",
+    "octopus-swap",
+    "octopus-no-target",
+    "penguin-flip-down",
+    "penguin-skipped",
+    "penguin-no-previous",
+    "penguin-no-target",
+    "walrus-block",
+    "walrus-skipped",
+    "crab-extra-flip",
+    "turtle-skip",
+    "ruby-awarded",
+    "no-rubies",
+    "no-winner",
+    "round-end",
+    "game-end"};
+static_assert(kEventNames.size() == static_cast<std::size_t>(EventType::GameEnd) + 1,
+              "Every EventType needs a protocol name");
+
+// Description: Appends an unsigned decimal number without going through a stream.
+// Parameters: out (std::string&), value (std::size_t).
+void append_number(std::string& out, std::size_t value) {
+    char digits[20];
+    std::size_t count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    while (count > 0) {
+        out += digits[--count];
+    }
+}
+
+// Description: Appends " options=" and the comma-separated cells of a mask.
+// Parameters: out (std::string&), mask (std::uint32_t) cell bits.
+void append_mask(std::string& out, std::uint32_t mask) {
+    out += " options=";
+    bool first = true;
+    for (; mask != 0; mask &= mask - 1) {
+        if (!first) {
+            out += ',';
+        }
+        first = false;
+        append_position(out, Board::positionOf(count_trailing_zeros(mask)));
+    }
+}
+
+// Description: Tells which optional fields an event type carries.
+// Parameters: type (EventType).
+// Returns: true when the field is meaningful for that type.
+bool has_seat(EventType type) {
+    return type != EventType::GameStart && type != EventType::RoundStart && type != EventType::NoWinner &&
+           type != EventType::RoundEnd && type != EventType::GameEnd;
+}
+
+bool has_position(EventType type) {
+    switch (type) {
+    case EventType::Flip:
+    case EventType::Mismatch:
+    case EventType::OctopusSwap:
+    case EventType::OctopusNoTarget:
+    case EventType::PenguinFlipDown:
+    case EventType::PenguinSkipped:
+    case EventType::PenguinNoPrevious:
+    case EventType::PenguinNoTarget:
+    case EventType::WalrusBlock:
+    case EventType::WalrusSkipped:
+    case EventType::CrabExtraFlip:
+    case EventType::TurtleSkip:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool has_target(EventType type) {
+    return type == EventType::OctopusSwap || type == EventType::PenguinFlipDown || type == EventType::WalrusBlock;
+}
+}
+
+void append_position(std::string& out, const Position& position) {
+    out += letter_symbol(position.letter);
+    out += number_symbol(position.number);
+}
+
+void append_card(std::string& out, const Card& card) {
+    out += animal_symbol(static_cast<FaceAnimal>(card));
+    out += background_symbol(static_cast<FaceBackground>(card));
+}
+
+const char* event_name(EventType type) {
+    return kEventNames[static_cast<std::size_t>(type)];
+}
+
+const char* input_name(InputKind kind) {
+    switch (kind) {
+    case InputKind::Flip:
+        return "flip";
+    case InputKind::OctopusTarget:
+        return "octopus";
+    case InputKind::PenguinTarget:
+        return "penguin";
+    case InputKind::WalrusBlock:
+        return "block";
+    case InputKind::None:
+        break;
+    }
+    return "none";
+}
+
+void append_event(std::string& out, const Game& game, const GameEvent& event) {
+    out += "event ";
+    out += event_name(event.type);
+    if (has_seat(event.type)) {
+        out += " seat=";
+        append_number(out, event.player);
+    }
+    if (has_position(event.type)) {
+        out += " pos=";
+        append_position(out, event.position);
+    }
+    if (has_target(event.type)) {
+        out += " target=";
+        append_position(out, event.target);
+    }
+    if (event.type == EventType::Flip) {
+        out += " card=";
+        append_card(out, game.board().cardAt(Board::indexOf(event.position)));
+    }
+    if (event.type == EventType::RoundStart || event.type == EventType::RubyAwarded) {
+        out += " value=";
+        append_number(out, static_cast<std::size_t>(event.value));
+    }
+    out += '\n';
+}
+
+void append_request(std::string& out, const Game& game, const InputRequest& request) {
+    out += "await ";
+    out += input_name(request.kind);
+    out += " seat=";
+    append_number(out, request.player);
+    if (request.kind == InputKind::OctopusTarget || request.kind == InputKind::PenguinTarget) {
+        out += " origin=";
+        append_position(out, request.origin);
+        append_mask(out, request.optionMask);
+    } else if (request.kind == InputKind::Flip) {
+        append_mask(out, game.board().flippableMask(request.blockActive));
+    } else if (request.kind == InputKind::WalrusBlock) {
+        append_mask(out, game.board().flippableMask(false));
+    }
+    out += '\n';
+}
+
+void append_peek(std::string& out, const Game& game, std::size_t seat) {
+    out += "peek";
+    for (std::uint32_t cells = peek_mask(game, seat); cells != 0; cells &= cells - 1) {
+        const unsigned index = count_trailing_zeros(cells);
+        out += ' ';
+        append_position(out, Board::positionOf(index));
+        out += '=';
+        append_card(out, game.board().cardAt(index));
+    }
+    out += '\n';
+}
+
+void append_state(std::string& out, const Game& game, const Engine& engine) {
+    const InputRequest& request = engine.pending();
+    const auto& players = game.players();
+    out += "state round=";
+    append_number(out, static_cast<std::size_t>(game.getRound()) + (engine.finished() ? 0 : 1));
+    out += " turn=";
+    append_number(out, request.player);
+    out += " await=";
+    out += input_name(request.kind);
+    out += " active=";
+    for (const auto& player : players) {
+        out += player.isActive() ? '1' : '0';
+    }
+    out += " rubies=";
+    for (std::size_t seat = 0; seat < players.size(); ++seat) {
+        if (seat > 0) {
+            out += ',';
+        }
+        append_number(out, static_cast<std::size_t>(players[seat].getNRubies()));
+    }
+    out += " current=";
+    if (const Card* current = game.getCurrentCard()) {
+        append_card(out, *current);
+    } else {
+        out += '-';
+    }
+    out += " previous=";
+    if (const Card* previous = game.getPreviousCard()) {
+        append_card(out, *previous);
+    } else {
+        out += '-';
+    }
+    out += " blocked=";
+    const std::uint32_t blocked = game.board().blockedMask();
+    if (blocked != 0) {
+        append_position(out, Board::positionOf(count_trailing_zeros(blocked)));
+    } else {
+        out += '-';
+    }
+    out += " up=";
+    bool first = true;
+    game.board().forEachFaceUp([&out, &first](const Position& pos, const Card& card) {
+        if (!first) {
+            out += ',';
+        }
+        first = false;
+        append_position(out, pos);
+        out += '=';
+        append_card(out, card);
+    });
+    out += '\n';
+}
+
+void append_frame(std::string& out, const Game& game) {
+    std::ostringstream frame;
+    frame << game;
+    const std::string text = frame.str();
+    out += "board\n";
+    std::size_t begin = 0;
+    while (begin < text.size()) {
+        std::size_t end = text.find('\n', begin);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        out += "| ";
+        out.append(text, begin, end - begin);
+        out += '\n';
+        begin = end + 1;
+    }
+    out += "end\n";
+}
+
+bool is_move_command(const std::string& command) {
+    return command == "flip" || command == "octopus" || command == "penguin" || command == "block";
+}
+
+MoveStatus submit_move(Engine& engine, const std::string& command, const std::string& argument) {
+    const InputKind kind = engine.pending().kind;
+    const bool optional = command == "penguin" || command == "block";
+    if (kind == InputKind::None || command != input_name(kind)) {
+        return MoveStatus::NotExpected;
+    }
+    const bool skip = argument == "skip";
+    Position target{Letter::A, Number::One};
+    const char* text = argument.data();
+    if ((skip && !optional) || (!skip && !parse_position(text, text + argument.size(), target))) {
+        return MoveStatus::BadArgument;
+    }
+
+    bool accepted = false;
+    switch (kind) {
+    case InputKind::Flip:
+        accepted = engine.submitFlip(target);
+        break;
+    case InputKind::OctopusTarget:
+        accepted = engine.submitOctopusTarget(target);
+        break;
+    case InputKind::PenguinTarget:
+        accepted = engine.submitPenguinTarget(!skip, target);
+        break;
+    case InputKind::WalrusBlock:
+        accepted = engine.submitWalrusBlock(!skip, target);
+        break;
+    case InputKind::None:
+        break;
+    }
+    return accepted ? MoveStatus::Accepted : MoveStatus::Illegal;
+}
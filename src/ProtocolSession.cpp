@@ -0,0 +1,200 @@
+// ProtocolSession implementation: command parsing and replies for the line protocol mode.
+#include "ProtocolSession.h"
+
+#include "Game.h"
+#include "Protocol.h"
+#include "Random.h"
+#include "Replay.h"
+#include "Script.h"
+#include "Seating.h"
+#include "Snapshot.h"
+
+namespace {
+// Description: Splits a command line into space-separated tokens.
+// Parameters: line (const std::string&), tokens (std::vector<std::string>&) output, reused between calls.
+void split(const std::string& line, std::vector<std::string>& tokens) {
+    tokens.clear();
+    std::size_t begin = line.find_first_not_of(" \t\r");
+    while (begin != std::string::npos) {
+        const std::size_t end = line.find_first_of(" \t\r", begin);
+        tokens.emplace_back(line, begin, end == std::string::npos ? std::string::npos : end - begin);
+        begin = end == std::string::npos ? end : line.find_first_not_of(" \t\r", end);
+    }
+}
+
+// Description: Parses the value of a "key=value" token as an unsigned number.
+// Parameters: text (const std::string&) the value, value (std::uint64_t&) output.
+// Returns: true when text is a non-empty decimal number that fits 64 bits; value is unchanged otherwise.
+bool parse_number(const std::string& text, std::uint64_t& value) {
+    const ScriptToken token{text.data(), text.data() + text.size()};
+    return token.toNumber(value);
+}
+}
+
+ProtocolSession::ProtocolSession(ReplayWriter* replay) : m_replay(replay) {}
+
+ProtocolSession::~ProtocolSession() = default;
+
+bool ProtocolSession::handle(const std::string& line, std::string& out) {
+    split(line, m_tokens);
+    if (m_tokens.empty()) {
+        return true;
+    }
+    const std::string& command = m_tokens[0];
+    m_out = &out;
+    if (command == "newgame") {
+        newGame(m_tokens, out);
+    } else if (is_move_command(command)) {
+        move(m_tokens, out);
+    } else if (command == "state") {
+        if (m_engine == nullptr) {
+            out += "error no game\n";
+        } else {
+            append_state(out, *m_game, *m_engine);
+        }
+    } else if (command == "board") {
+        if (m_engine == nullptr) {
+            out += "error no game\n";
+        } else {
+            append_frame(out, *m_game);
+        }
+    } else if (command == "isready") {
+        out += "readyok\n";
+    } else if (command == "quit") {
+        m_out = nullptr;
+        return false;
+    } else {
+        out += "error unknown command\n";
+    }
+    m_out = nullptr;
+    return true;
+}
+
+void ProtocolSession::onEvent(const Game& game, const GameEvent& event) {
+    if (!m_events || m_out == nullptr) {
+        return;
+    }
+    append_event(*m_out, game, event);
+    if (event.type == EventType::Peek && event.player < m_firstBot) {
+        append_peek(*m_out, game, event.player);
+    }
+}
+
+// newgame [seed=N] [players=N] [bots=N] [rules=base|expert] [events=on|off]
+void ProtocolSession::newGame(const std::vector<std::string>& tokens, std::string& out) {
+    std::uint64_t seed = 0;
+    std::uint64_t players = 2;
+    std::uint64_t bots = 0;
+    RulesMode rulesMode = RulesMode::Base;
+    bool events = true;
+    for (std::size_t i = 1; i < tokens.size(); ++i) {
+        const std::string& token = tokens[i];
+        const std::size_t equals = token.find('=');
+        const std::string key = token.substr(0, equals);
+        const std::string value = equals == std::string::npos ? std::string() : token.substr(equals + 1);
+        bool valid = true;
+        if (key == "seed") {
+            valid = parse_number(value, seed);
+        } else if (key == "players") {
+            valid = parse_number(value, players);
+        } else if (key == "bots") {
+            valid = parse_number(value, bots);
+        } else if (key == "rules") {
+            valid = value == "base" || value == "expert";
+            rulesMode = value == "expert" ? RulesMode::Expert : RulesMode::Base;
+        } else if (key == "events") {
+            valid = value == "on" || value == "off";
+            events = value == "on";
+        } else {
+            valid = false;
+        }
+        if (!valid) {
+            out += "error bad option " + token + '\n';
+            return;
+        }
+    }
+    if (players < 2 || players > kMaxSeats || bots > players) {
+        out += "error players must be 2-" + std::to_string(kMaxSeats) + " and bots at most players\n";
+        return;
+    }
+    if (m_replay != nullptr && players > GameSnapshot::kMaxPlayers) {
+        out += "error recorded games have at most " + std::to_string(GameSnapshot::kMaxPlayers) + " players\n";
+        return;
+    }
+
+    m_recorder.reset();
+    m_engine.reset();
+    m_game.reset();
+    m_bots.clear();
+    Xoshiro256 rng(seed);
+    m_cardDeck.setGenerator(rng.split());
+    m_cardDeck.reset();
+    m_cardDeck.shuffle();
+    m_rubisDeck.setGenerator(rng.split());
+    m_rubisDeck.reset();
+    m_rubisDeck.shuffle();
+    GameOptions gameOptions;
+    gameOptions.rulesMode = rulesMode;
+    m_game.reset(new Game(m_cardDeck, gameOptions));
+    m_engine.reset(new Engine(*m_game, m_rules, m_rubisDeck));
+    const std::uint64_t agentSeed = rng();
+    m_firstBot = static_cast<std::size_t>(players - bots);
+    for (std::size_t seat = 0; seat < players; ++seat) {
+        m_game->addPlayer(Player((seat < m_firstBot ? "P" : "Bot ") + std::to_string(seat + 1),
+                                 seat_side(seat, static_cast<std::size_t>(players))));
+        if (seat >= m_firstBot) {
+            m_bots.emplace_back(new MemoryAgent(agentSeed + seat));
+            m_engine->setAgent(seat, *m_bots.back());
+            m_engine->addObserver(*m_bots.back());
+        }
+    }
+    m_engine->addObserver(*this);
+    if (m_replay != nullptr) {
+        m_recorder.reset(new ReplayRecorder(*m_replay, *m_engine, seed));
+        m_engine->addObserver(*m_recorder);
+    }
+    m_events = events;
+
+    out += "ok newgame seed=" + std::to_string(seed) + " players=" + std::to_string(players) +
+           " bots=" + std::to_string(bots) + (rulesMode == RulesMode::Expert ? " rules=expert\n" : " rules=base\n");
+    resume(out);
+}
+
+void ProtocolSession::move(const std::vector<std::string>& tokens, std::string& out) {
+    if (m_engine == nullptr || m_engine->finished()) {
+        out += "error no game\n";
+        return;
+    }
+    const InputKind pending = m_engine->pending().kind;
+    switch (submit_move(*m_engine, tokens[0], tokens.size() == 2 ? tokens[1] : std::string())) {
+    case MoveStatus::Accepted:
+        resume(out);
+        break;
+    case MoveStatus::Illegal:
+        out += "error illegal move\n";
+        break;
+    case MoveStatus::NotExpected:
+        out += std::string("error expected ") + input_name(pending) + '\n';
+        break;
+    case MoveStatus::BadArgument:
+        out += "error expected: " + tokens[0] + " <position>\n";
+        break;
+    }
+}
+
+void ProtocolSession::resume(std::string& out) {
+    const InputRequest& request = m_engine->advance();
+    if (request.kind != InputKind::None) {
+        append_request(out, *m_game, request);
+        return;
+    }
+    out += "gameover rubies=";
+    const auto& players = m_game->players();
+    for (std::size_t seat = 0; seat < players.size(); ++seat) {
+        if (seat > 0) {
+            out += ',';
+        }
+        out += std::to_string(players[seat].getNRubies());
+    }
+    out += '\n';
+}
@@ -0,0 +1,53 @@
+// RandomAgent implementation: uniform choices over the legal moves of the current board.
+#include "RandomAgent.h"
+
+#include "Game.h"
+
+#include <stdexcept>
+
+template <class Geometry>
+BasicRandomAgent<Geometry>::BasicRandomAgent(std::uint32_t seed) : m_rng(seed) {}
+
+template <class Geometry>
+Position BasicRandomAgent<Geometry>::chooseFlip(const BasicGame<Geometry>& game, const Player&, bool blockActive) {
+    return randomFaceDown(game, blockActive);
+}
+
+template <class Geometry>
+Position BasicRandomAgent<Geometry>::chooseOctopusTarget(const BasicGame<Geometry>&, const Player&, const Position&,
+                                                         const std::vector<Position>& options) {
+    return options[m_rng.bounded(static_cast<std::uint32_t>(options.size()))];
+}
+
+template <class Geometry>
+bool BasicRandomAgent<Geometry>::choosePenguinTarget(const BasicGame<Geometry>&, const Player&,
+                                                     const std::vector<Position>& options, Position& target) {
+    std::size_t index = m_rng.bounded(static_cast<std::uint32_t>(options.size() + 1));
+    if (index == options.size()) {
+        return false;
+    }
+    target = options[index];
+    return true;
+}
+
+template <class Geometry>
+bool BasicRandomAgent<Geometry>::chooseWalrusBlock(const BasicGame<Geometry>& game, const Player&, Position& target) {
+    if (!game.board().hasFaceDownCards()) {
+        return false;
+    }
+    target = randomFaceDown(game, false);
+    return true;
+}
+
+template <class Geometry>
+Position BasicRandomAgent<Geometry>::randomFaceDown(const BasicGame<Geometry>& game, bool blockActive) {
+    const typename Geometry::Mask candidates = game.board().flippableMask(blockActive);
+    if (!MaskOps<typename Geometry::Mask>::any(candidates)) {
+        throw std::logic_error("No face-down card available");
+    }
+    return BasicBoard<Geometry>::positionOf(random_cell(candidates, m_rng));
+}
+
+template class BasicRandomAgent<ClassicGeometry>;
+template class BasicRandomAgent<Geometry7x7>;
+template class BasicRandomAgent<Geometry9x9>;
@@ -0,0 +1,213 @@
+// FrameWriter implementation: table-driven, allocation-free board and expert rendering.
+#include "Renderer.h"
+
+#include "Board.h"
+#include "Game.h"
+#include "Trace.h"
+
+#include <cstring>
+#include <ostream>
+
+namespace {
+constexpr char kBackgroundGlyphs[] = "rgpby";
+constexpr char kAnimalGlyphs[] = "CPOTW";
+constexpr char kLetterGlyphs[] = "ABCDE";
+constexpr char kNumberGlyphs[] = "12345";
+// Blank line between board rows: two label columns plus five 3-wide cells separated by spaces.
+constexpr char kSpacerRow[] = "                     \n";
+
+// Three text rows of three characters for every card id.
+struct GlyphTable {
+    char rows[Card::kCount][3][3];
+};
+
+// Description: Builds the glyph table at compile time (same layout as Card::operator()).
+// Returns: GlyphTable for all 25 cards.
+constexpr GlyphTable make_glyph_table() {
+    GlyphTable table{};
+    for (std::size_t id = 0; id < Card::kCount; ++id) {
+        const char background = kBackgroundGlyphs[id % 5];
+        for (std::size_t row = 0; row < 3; ++row) {
+            for (std::size_t col = 0; col < 3; ++col) {
+                table.rows[id][row][col] = background;
+            }
+        }
+        table.rows[id][1][1] = kAnimalGlyphs[id / 5];
+    }
+    return table;
+}
+
+constexpr GlyphTable kGlyphs = make_glyph_table();
+}
+
+FrameWriter::FrameWriter(std::ostream& os) : m_os(os) {}
+
+FrameWriter::~FrameWriter() {
+    flush();
+}
+
+void FrameWriter::appendBoard(const Board& board) {
+    const std::uint32_t occupied = board.occupiedMask();
+    const std::uint32_t faceUp = board.faceUpMask();
+    for (std::size_t row = 0; row < Board::kRows; ++row) {
+        for (std::size_t inner = 0; inner < 3; ++inner) {
+            put(inner == 1 ? kLetterGlyphs[row] : ' ');
+            put(' ');
+            for (std::size_t col = 0; col < Board::kColumns; ++col) {
+                if (col > 0) {
+                    put(' ');
+                }
+                const std::size_t index = row * Board::kColumns + col;
+                if (!((occupied >> index) & 1u)) {
+                    put("   ", 3);
+                } else if (!((faceUp >> index) & 1u)) {
+                    put("zzz", 3);
+                } else {
+                    putGlyphRow(board.cardAt(index).id(), inner);
+                }
+            }
+            put('\n');
+        }
+        if (row + 1 < Board::kRows) {
+            put(kSpacerRow, sizeof(kSpacerRow) - 1);
+        }
+    }
+
+    put("  ", 2);
+    for (std::size_t col = 0; col < Board::kColumns; ++col) {
+        if (col > 0) {
+            put(' ');
+        }
+        put(' ');
+        put(kNumberGlyphs[col]);
+        put(' ');
+    }
+    put('\n');
+}
+
+void FrameWriter::appendExpertRow(const Board& board) {
+    const std::uint32_t faceUp = board.faceUpMask();
+    if (faceUp == 0) {
+        putText("No cards are currently face up.\n");
+        return;
+    }
+    for (std::size_t row = 0; row < 3; ++row) {
+        for (std::uint32_t mask = faceUp; mask != 0; mask &= mask - 1) {
+            const unsigned index = count_trailing_zeros(mask);
+            if (mask != faceUp) {
+                put(' ');
+            }
+            putGlyphRow(board.cardAt(index).id(), row);
+        }
+        put('\n');
+    }
+    for (std::uint32_t mask = faceUp; mask != 0; mask &= mask - 1) {
+        const unsigned index = count_trailing_zeros(mask);
+        if (mask != faceUp) {
+            put(' ');
+        }
+        put(kLetterGlyphs[index / Board::kColumns]);
+        put(kNumberGlyphs[index % Board::kColumns]);
+    }
+    put('\n');
+}
+
+void FrameWriter::appendPlayer(const Player& player) {
+    put(player.getName().data(), player.getName().size());
+    put(": ", 2);
+    if (player.displaysRubies()) {
+        putInt(player.getNRubies());
+        putText(player.getNRubies() == 1 ? " ruby" : " rubies");
+    } else {
+        putText(side_name(player.getSide()));
+        putText(player.isActive() ? " (active)" : " (inactive)");
+    }
+}
+
+void FrameWriter::appendGame(const Game& game) {
+    TRACE_SCOPE("render");
+    if (game.displayMode() == DisplayMode::Base) {
+        appendBoard(game.board());
+    } else {
+        appendExpertRow(game.board());
+    }
+    for (const auto& player : game.players()) {
+        appendPlayer(player);
+        put('\n');
+    }
+}
+
+void FrameWriter::appendText(const char* text) {
+    putText(text);
+}
+
+void FrameWriter::appendText(const std::string& text) {
+    put(text.data(), text.size());
+}
+
+void FrameWriter::appendNumber(int value) {
+    putInt(value);
+}
+
+void FrameWriter::flush() {
+    if (m_size > 0) {
+        m_os.write(m_buffer.data(), static_cast<std::streamsize>(m_size));
+        m_size = 0;
+    }
+}
+
+const char* FrameWriter::data() const {
+    return m_buffer.data();
+}
+
+std::size_t FrameWriter::size() const {
+    return m_size;
+}
+
+void FrameWriter::clear() {
+    m_size = 0;
+}
+
+void FrameWriter::put(char c) {
+    if (m_size == kCapacity) {
+        flush();
+    }
+    m_buffer[m_size++] = c;
+}
+
+void FrameWriter::put(const char* text, std::size_t length) {
+    while (length > 0) {
+        if (m_size == kCapacity) {
+            flush();
+        }
+        const std::size_t chunk = length < kCapacity - m_size ? length : kCapacity - m_size;
+        std::memcpy(m_buffer.data() + m_size, text, chunk);
+        m_size += chunk;
+        text += chunk;
+        length -= chunk;
+    }
+}
+
+void FrameWriter::putText(const char* text) {
+    put(text, std::strlen(text));
+}
+
+void FrameWriter::putInt(int value) {
+    char digits[12];
+    std::size_t count = 0;
+    unsigned magnitude = value < 0 ? 0u - static_cast<unsigned>(value) : static_cast<unsigned>(value);
+    do {
+        digits[count++] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (value < 0) {
+        put('-');
+    }
+    while (count > 0) {
+        put(digits[--count]);
+    }
+}
+
+void FrameWriter::putGlyphRow(CardId card, std::size_t row) {
+    put(kGlyphs.rows[card][row], 3);
+}
@@ -0,0 +1,309 @@
+// Replay implementation: append-only game logs, log-driven agents and the parallel replayer.
+#include "Replay.h"
+
+#include "Board.h"
+#include "CardDeck.h"
+#include "Engine.h"
+#include "MappedFile.h"
+#include "RubisDeck.h"
+#include "Rules.h"
+#include "ThreadPool.h"
+
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+static_assert(sizeof(ReplayRecord) == 5, "ReplayRecord must stay packed");
+static_assert(std::is_trivially_copyable<ReplayGameHeader>::value, "ReplayGameHeader is written as raw bytes");
+
+namespace {
+// Description: Tells whether an event carries an agent decision the replayer has to feed back.
+// Parameters: type (EventType).
+// Returns: true for flips and ability choices.
+bool is_decision(EventType type) {
+    switch (type) {
+    case EventType::Flip:
+    case EventType::OctopusSwap:
+    case EventType::PenguinFlipDown:
+    case EventType::PenguinSkipped:
+    case EventType::WalrusBlock:
+    case EventType::WalrusSkipped:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Description: Compares two records field by field.
+// Parameters: a/b (const ReplayRecord&).
+// Returns: true when identical.
+bool same_record(const ReplayRecord& a, const ReplayRecord& b) {
+    return a.type == b.type && a.player == b.player && a.position == b.position && a.target == b.target &&
+           a.value == b.value;
+}
+
+// Checks every event of a replayed game against its log and keeps the first difference.
+class ReplayVerifier : public GameObserver {
+public:
+    ReplayVerifier(const ReplayRecord* records, std::size_t count) : m_records(records), m_count(count) {}
+
+    void onEvent(const Game&, const GameEvent& event) override {
+        if (!diverged) {
+            if (m_seen >= m_count) {
+                fail("engine emitted more events than recorded");
+            } else if (!same_record(to_record(event), m_records[m_seen])) {
+                fail("event " + std::to_string(m_seen) + " differs from the log");
+            }
+        }
+        ++m_seen;
+    }
+
+    // No parameters. Records a failure if the engine stopped before the log did.
+    void finish() {
+        if (!diverged && m_seen != m_count) {
+            fail("engine emitted fewer events than recorded");
+        }
+    }
+
+    void fail(const std::string& reason) {
+        diverged = true;
+        message = reason;
+    }
+
+    bool diverged{false};
+    std::string message;
+
+private:
+    const ReplayRecord* m_records;
+    std::size_t m_count;
+    std::size_t m_seen{0};
+};
+
+// Per-worker decks reused across replayed games.
+struct ReplayWorker {
+    CardDeck cardDeck;
+    RubisDeck rubisDeck;
+};
+
+// Result of re-executing one recorded game.
+struct GameOutcome {
+    std::size_t events{0};
+    bool diverged{false};
+    std::string message;
+};
+
+// Description: Re-executes one game block and verifies it against its records.
+// Parameters: header (const ReplayGameHeader&), records (const ReplayRecord*), worker (ReplayWorker&).
+// Returns: GameOutcome.
+GameOutcome replay_game(const ReplayGameHeader& header, const ReplayRecord* records, ReplayWorker& worker) {
+    GameOutcome outcome;
+    outcome.events = header.recordCount;
+
+    worker.cardDeck.reset();
+    GameOptions options;
+    options.rulesMode = static_cast<RulesMode>(header.rulesMode);
+    Game game(worker.cardDeck, options);
+    for (std::size_t seat = 0; seat < header.start.playerCount; ++seat) {
+        game.addPlayer(Player("P" + std::to_string(seat + 1), static_cast<Side>((header.start.sides >> (seat * 2)) & 3u)));
+    }
+
+    Rules rules;
+    Engine engine(game, rules, worker.rubisDeck);
+    ReplayAgent agent(records, header.recordCount);
+    ReplayVerifier verifier(records, header.recordCount);
+    for (std::size_t seat = 0; seat < header.start.playerCount; ++seat) {
+        engine.setAgent(seat, agent);
+    }
+    engine.addObserver(verifier);
+
+    try {
+        engine.restore(header.start);
+        engine.playGame();
+        verifier.finish();
+    } catch (const std::exception& ex) {
+        // Divergent agents answer illegal moves, which the engine rejects with logic_error.
+        if (!verifier.diverged) {
+            verifier.fail(ex.what());
+        }
+    }
+    outcome.diverged = verifier.diverged;
+    outcome.message = verifier.message;
+    return outcome;
+}
+}
+
+ReplayRecord to_record(const GameEvent& event) {
+    ReplayRecord record;
+    record.type = static_cast<std::uint8_t>(event.type);
+    record.player = static_cast<std::uint8_t>(event.player);
+    record.position = static_cast<std::uint8_t>(Board::indexOf(event.position));
+    record.target = static_cast<std::uint8_t>(Board::indexOf(event.target));
+    record.value = static_cast<std::uint8_t>(event.value);
+    return record;
+}
+
+GameEvent to_event(const ReplayRecord& record) {
+    if (record.type > static_cast<std::uint8_t>(EventType::GameEnd) || record.position >= Board::kCells ||
+        record.target >= Board::kCells) {
+        throw std::runtime_error("Corrupt replay record");
+    }
+    GameEvent event;
+    event.type = static_cast<EventType>(record.type);
+    event.player = record.player;
+    event.position = Board::positionOf(record.position);
+    event.target = Board::positionOf(record.target);
+    event.value = record.value;
+    return event;
+}
+
+ReplayWriter::ReplayWriter(const std::string& path) : m_out(path, std::ios::binary | std::ios::app) {
+    if (!m_out) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    m_out.seekp(0, std::ios::end);
+    if (m_out.tellp() == std::streampos(0)) {
+        const ReplayFileHeader header;
+        m_out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+}
+
+void ReplayWriter::append(const std::vector<std::uint8_t>& block) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_out.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(block.size()));
+}
+
+void ReplayWriter::flush() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_out.flush();
+}
+
+ReplayRecorder::ReplayRecorder(ReplayWriter& writer, const Engine& engine, std::uint64_t seed)
+    : m_writer(writer), m_engine(engine) {
+    m_header.seed = seed;
+}
+
+void ReplayRecorder::onEvent(const Game& game, const GameEvent& event) {
+    if (event.type == EventType::GameStart) {
+        m_header.recordCount = 0;
+        m_header.rulesMode = static_cast<std::uint8_t>(game.rulesMode());
+        m_header.start = m_engine.snapshot();
+        // Space for the header, filled in once the record count is known.
+        m_block.assign(sizeof(ReplayGameHeader), 0);
+    }
+
+    const ReplayRecord record = to_record(event);
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(&record);
+    m_block.insert(m_block.end(), bytes, bytes + sizeof(record));
+    ++m_header.recordCount;
+
+    if (event.type == EventType::GameEnd) {
+        std::memcpy(m_block.data(), &m_header, sizeof(m_header));
+        m_writer.append(m_block);
+    }
+}
+
+ReplayAgent::ReplayAgent(const ReplayRecord* records, std::size_t count) : m_records(records), m_count(count) {}
+
+Position ReplayAgent::chooseFlip(const Game&, const Player&, bool) {
+    return Board::positionOf(nextDecision(EventType::Flip, EventType::Flip).position);
+}
+
+Position ReplayAgent::chooseOctopusTarget(const Game&, const Player&, const Position&, const std::vector<Position>&) {
+    return Board::positionOf(nextDecision(EventType::OctopusSwap, EventType::OctopusSwap).target);
+}
+
+bool ReplayAgent::choosePenguinTarget(const Game&, const Player&, const std::vector<Position>&, Position& target) {
+    const ReplayRecord& record = nextDecision(EventType::PenguinFlipDown, EventType::PenguinSkipped);
+    if (record.type == static_cast<std::uint8_t>(EventType::PenguinSkipped)) {
+        return false;
+    }
+    target = Board::positionOf(record.target);
+    return true;
+}
+
+bool ReplayAgent::chooseWalrusBlock(const Game&, const Player&, Position& target) {
+    const ReplayRecord& record = nextDecision(EventType::WalrusBlock, EventType::WalrusSkipped);
+    if (record.type == static_cast<std::uint8_t>(EventType::WalrusSkipped)) {
+        return false;
+    }
+    target = Board::positionOf(record.target);
+    return true;
+}
+
+const ReplayRecord& ReplayAgent::nextDecision(EventType expected, EventType alternative) {
+    while (m_cursor < m_count && !is_decision(static_cast<EventType>(m_records[m_cursor].type))) {
+        ++m_cursor;
+    }
+    if (m_cursor == m_count) {
+        throw ReplayDivergence("log has no further decisions");
+    }
+    const ReplayRecord& record = m_records[m_cursor++];
+    if (record.type != static_cast<std::uint8_t>(expected) && record.type != static_cast<std::uint8_t>(alternative)) {
+        throw ReplayDivergence("engine asked for a different decision than recorded");
+    }
+    if (record.position >= Board::kCells || record.target >= Board::kCells) {
+        throw ReplayDivergence("corrupt decision record");
+    }
+    return record;
+}
+
+ReplayReport replay_log(const std::string& path, std::size_t threads) {
+    MappedFile file(path);
+    ReplayFileHeader fileHeader;
+    if (file.size() < sizeof(fileHeader)) {
+        throw std::runtime_error("Not a replay log: " + path);
+    }
+    std::memcpy(&fileHeader, file.data(), sizeof(fileHeader));
+    if (fileHeader.magic != ReplayFileHeader::kMagic || fileHeader.version != ReplayFileHeader::kVersion) {
+        throw std::runtime_error("Not a replay log: " + path);
+    }
+
+    // Index the blocks first so that games can be replayed in parallel.
+    std::vector<std::size_t> offsets;
+    std::size_t offset = sizeof(fileHeader);
+    while (offset < file.size()) {
+        ReplayGameHeader header;
+        if (file.size() - offset < sizeof(header)) {
+            throw std::runtime_error("Truncated replay log");
+        }
+        std::memcpy(&header, file.data() + offset, sizeof(header));
+        if (header.magic != ReplayGameHeader::kMagic || header.rulesMode > 1 || !is_valid(header.start)) {
+            throw std::runtime_error("Corrupt replay log");
+        }
+        const std::size_t blockSize = sizeof(header) + std::size_t{header.recordCount} * sizeof(ReplayRecord);
+        if (file.size() - offset < blockSize) {
+            throw std::runtime_error("Truncated replay log");
+        }
+        offsets.push_back(offset);
+        offset += blockSize;
+    }
+
+    std::vector<GameOutcome> outcomes(offsets.size());
+    WorkStealingPool pool(threads);
+    std::vector<std::unique_ptr<ReplayWorker>> workers;
+    for (std::size_t i = 0; i < pool.size(); ++i) {
+        workers.emplace_back(new ReplayWorker());
+    }
+    pool.parallelFor(offsets.size(), [&](std::size_t index, std::size_t worker) {
+        ReplayGameHeader header;
+        std::memcpy(&header, file.data() + offsets[index], sizeof(header));
+        const auto* records = reinterpret_cast<const ReplayRecord*>(file.data() + offsets[index] + sizeof(header));
+        outcomes[index] = replay_game(header, records, *workers[worker]);
+    });
+
+    ReplayReport report;
+    report.games = offsets.size();
+    for (std::size_t index = 0; index < outcomes.size(); ++index) {
+        report.events += outcomes[index].events;
+        if (outcomes[index].diverged) {
+            if (report.divergent == 0) {
+                ReplayGameHeader header;
+                std::memcpy(&header, file.data() + offsets[index], sizeof(header));
+                report.firstDivergentSeed = header.seed;
+                report.firstDivergence = outcomes[index].message;
+            }
+            ++report.divergent;
+        }
+    }
+    return report;
+}
@@ -1,7 +1,11 @@
 // RubisDeck implementation: builds/reset the deck with assignment ruby counts.
 #include "RubisDeck.h"
 
-#include <memory>
+#include "Snapshot.h"
+
+#include <stdexcept>
+
+static_assert(RubisDeck::kCapacity <= GameSnapshot::kMaxRubies, "Snapshots must hold a full ruby deck");
 
 RubisDeck& RubisDeck::make_RubisDeck() {
     static RubisDeck deck;
@@ -13,14 +17,13 @@ RubisDeck::RubisDeck() {
 }
 
 void RubisDeck::reset() {
-    clear();
-    build();
+    refill();
 }
 
 void RubisDeck::build() {
     auto push_value = [this](int value, int count) {
         while (count-- > 0) {
-            push(std::unique_ptr<Rubis>(new Rubis(value)));
+            add(Rubis(value));
         }
     };
 
@@ -29,3 +32,34 @@ void RubisDeck::build() {
     push_value(3, 1);
     push_value(4, 1);
 }
+
+void RubisDeck::saveState(GameSnapshot& snapshot) const {
+    snapshot.rubyGenerator = m_rng;
+    snapshot.rubyCount = static_cast<std::uint8_t>(m_size);
+    snapshot.rubyDeck.fill(0);
+    for (std::size_t index = 0; index < m_size; ++index) {
+        snapshot.rubyDeck[index] = static_cast<std::uint8_t>(static_cast<int>(element(m_order[index])));
+    }
+}
+
+void RubisDeck::restoreState(const GameSnapshot& snapshot) {
+    if (!is_valid(snapshot)) {
+        throw std::invalid_argument("Invalid snapshot");
+    }
+    // Each remaining ruby is matched to an unused pool slot of the same value.
+    std::uint32_t used = 0;
+    std::size_t size = 0;
+    for (std::size_t index = 0; index < snapshot.rubyCount; ++index) {
+        std::size_t slot = 0;
+        while (slot < m_built && (((used >> slot) & 1u) || static_cast<int>(element(slot)) != snapshot.rubyDeck[index])) {
+            ++slot;
+        }
+        if (slot == m_built) {
+            throw std::invalid_argument("Snapshot ruby deck does not match the ruby distribution");
+        }
+        used |= 1u << slot;
+        m_order[size++] = static_cast<std::uint8_t>(slot);
+    }
+    m_size = size;
+    m_rng = snapshot.rubyGenerator;
+}
@@ -1,47 +1,66 @@
 // Rules implementation: validates matches and detects round/game termination.
 #include "Rules.h"
 
-#include <algorithm>
-#include <stdexcept>
+#include "Trace.h"
 
-Rules::Rules(bool expertRules) : m_useExpertRules(expertRules) {}
+#include <stdexcept>
 
-bool Rules::isValid(const Game& game) const {
-    const Card* previous = game.getPreviousCard();
-    const Card* current = game.getCurrentCard();
+template <class Geometry>
+bool Rules::isValid(const BasicGame<Geometry>& game) const {
+    TRACE_SCOPE("rules.isValid");
+    const BasicCard<Geometry>* previous = game.getPreviousCard();
+    const BasicCard<Geometry>* current = game.getCurrentCard();
     if (current == nullptr) {
         return false;
     }
     if (previous == nullptr) {
         return true;
     }
-    FaceAnimal prevAnimal = static_cast<FaceAnimal>(*previous);
-    FaceAnimal currAnimal = static_cast<FaceAnimal>(*current);
-    FaceBackground prevBackground = static_cast<FaceBackground>(*previous);
-    FaceBackground currBackground = static_cast<FaceBackground>(*current);
+    return matches(*previous, *current);
+}
+
+template <class Geometry>
+bool Rules::matches(const BasicCard<Geometry>& previous, const BasicCard<Geometry>& current) {
+    FaceAnimal prevAnimal = static_cast<FaceAnimal>(previous);
+    FaceAnimal currAnimal = static_cast<FaceAnimal>(current);
+    FaceBackground prevBackground = static_cast<FaceBackground>(previous);
+    FaceBackground currBackground = static_cast<FaceBackground>(current);
     return prevAnimal == currAnimal || prevBackground == currBackground;
 }
 
-bool Rules::gameOver(const Game& game) const {
-    return game.getRound() >= 7;
+template <class Geometry>
+bool Rules::gameOver(const BasicGame<Geometry>& game) const {
+    return game.getRound() >= kRounds;
 }
 
-bool Rules::roundOver(const Game& game) const {
-    const auto& players = game.players();
-    return std::count_if(players.begin(), players.end(), [](const Player& player) { return player.isActive(); }) <= 1;
+template <class Geometry>
+bool Rules::roundOver(const BasicGame<Geometry>& game) const {
+    return game.activeCount() <= 1;
 }
 
-const Player& Rules::getNextPlayer(const Game& game) const {
+template <class Geometry>
+const Player& Rules::getNextPlayer(const BasicGame<Geometry>& game) const {
     const auto& players = game.players();
     if (players.empty()) {
         throw std::runtime_error("No players available");
     }
-    std::size_t start = game.currentPlayerIndex();
-    for (std::size_t offset = 1; offset <= players.size(); ++offset) {
-        std::size_t index = (start + offset) % players.size();
-        if (players[index].isActive()) {
-            return players[index];
-        }
-    }
-    return players[start];
+    return players[game.nextActivePlayer(game.currentPlayerIndex())];
 }
+
+template bool Rules::isValid(const BasicGame<ClassicGeometry>&) const;
+template bool Rules::matches(const BasicCard<ClassicGeometry>&, const BasicCard<ClassicGeometry>&);
+template bool Rules::gameOver(const BasicGame<ClassicGeometry>&) const;
+template bool Rules::roundOver(const BasicGame<ClassicGeometry>&) const;
+template const Player& Rules::getNextPlayer(const BasicGame<ClassicGeometry>&) const;
+
+template bool Rules::isValid(const BasicGame<Geometry7x7>&) const;
+template bool Rules::matches(const BasicCard<Geometry7x7>&, const BasicCard<Geometry7x7>&);
+template bool Rules::gameOver(const BasicGame<Geometry7x7>&) const;
+template bool Rules::roundOver(const BasicGame<Geometry7x7>&) const;
+template const Player& Rules::getNextPlayer(const BasicGame<Geometry7x7>&) const;
+
+template bool Rules::isValid(const BasicGame<Geometry9x9>&) const;
+template bool Rules::matches(const BasicCard<Geometry9x9>&, const BasicCard<Geometry9x9>&);
+template bool Rules::gameOver(const BasicGame<Geometry9x9>&) const;
+template bool Rules::roundOver(const BasicGame<Geometry9x9>&) const;
+template const Player& Rules::getNextPlayer(const BasicGame<Geometry9x9>&) const;
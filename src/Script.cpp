@@ -0,0 +1,346 @@
+// Script implementation: in-place tokenizer over mapped match scripts and the scripted game loop.
+#include "Script.h"
+
+#include "CardDeck.h"
+#include "Engine.h"
+#include "Game.h"
+#include "MemoryAgent.h"
+#include "Random.h"
+#include "Replay.h"
+#include "RubisDeck.h"
+#include "Rules.h"
+#include "Seating.h"
+#include "Snapshot.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+namespace {
+// Description: Builds the error for a script line.
+// Parameters: line (const ScriptLine&), message (const char*).
+// Returns: ScriptError "script line N: message".
+ScriptError line_error(const ScriptLine& line, const char* message) {
+    return ScriptError("script line " + std::to_string(line.number) + ": " + message);
+}
+
+// Description: Parses a side name.
+// Parameters: token (const ScriptToken&), side (Side&) output.
+// Returns: true for top, bottom, left or right.
+bool parse_side(const ScriptToken& token, Side& side) {
+    for (Side candidate : kClassicSeatOrder) {
+        if (token.is(side_name(candidate))) {
+            side = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Description: Checks whether a position is one of the listed options.
+// Parameters: options (const std::vector<Position>&), target (const Position&).
+// Returns: true when listed.
+bool listed(const std::vector<Position>& options, const Position& target) {
+    return std::find(options.begin(), options.end(), target) != options.end();
+}
+
+// Settings of one "game" line.
+struct GameSetup {
+    std::uint64_t seed{0};
+    std::uint64_t bots{0};
+    GameOptions options;
+};
+
+// Description: Reads the key=value tokens of a "game" line.
+// Parameters: line (const ScriptLine&), setup (GameSetup&) output.
+// Throws ScriptError for an unknown key or value.
+void parse_game(const ScriptLine& line, GameSetup& setup) {
+    for (std::size_t i = 1; i < line.count; ++i) {
+        const ScriptToken& token = line.tokens[i];
+        const char* equals = std::find(token.begin, token.end, '=');
+        const ScriptToken key{token.begin, equals};
+        const ScriptToken value{equals == token.end ? equals : equals + 1, token.end};
+        bool valid = true;
+        if (key.is("seed")) {
+            valid = value.toNumber(setup.seed);
+        } else if (key.is("bots")) {
+            valid = value.toNumber(setup.bots);
+        } else if (key.is("rules")) {
+            valid = value.is("base") || value.is("expert");
+            setup.options.rulesMode = value.is("expert") ? RulesMode::Expert : RulesMode::Base;
+        } else if (key.is("display")) {
+            valid = value.is("base") || value.is("expert");
+            setup.options.displayMode = value.is("expert") ? DisplayMode::Expert : DisplayMode::Base;
+        } else {
+            valid = false;
+        }
+        if (!valid) {
+            throw line_error(line, "bad game option");
+        }
+    }
+}
+}
+
+bool ScriptToken::is(const char* text) const {
+    const std::size_t size = static_cast<std::size_t>(end - begin);
+    return std::strlen(text) == size && std::memcmp(begin, text, size) == 0;
+}
+
+bool ScriptToken::toNumber(std::uint64_t& value) const {
+    if (begin == end) {
+        return false;
+    }
+    std::uint64_t result = 0;
+    for (const char* cursor = begin; cursor != end; ++cursor) {
+        if (*cursor < '0' || *cursor > '9') {
+            return false;
+        }
+        const auto digit = static_cast<std::uint64_t>(*cursor - '0');
+        if (result > (std::numeric_limits<std::uint64_t>::max() - digit) / 10) {
+            return false;
+        }
+        result = result * 10 + digit;
+    }
+    value = result;
+    return true;
+}
+
+std::string ScriptToken::str() const {
+    return std::string(begin, end);
+}
+
+bool split_line(const char* begin, const char* end, ScriptLine& line) {
+    line.count = 0;
+    const char* cursor = begin;
+    while (cursor < end) {
+        while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r')) {
+            ++cursor;
+        }
+        if (cursor == end || (line.count == 0 && *cursor == '#')) {
+            break;
+        }
+        const char* tokenEnd = cursor;
+        while (tokenEnd < end && *tokenEnd != ' ' && *tokenEnd != '\t' && *tokenEnd != '\r') {
+            ++tokenEnd;
+        }
+        if (line.count == ScriptLine::kMaxTokens) {
+            return false;
+        }
+        line.tokens[line.count++] = ScriptToken{cursor, tokenEnd};
+        cursor = tokenEnd;
+    }
+    return true;
+}
+
+ScriptReader::ScriptReader(const std::string& path)
+    : m_file(path),
+      m_cursor(reinterpret_cast<const char*>(m_file.data())),
+      m_end(m_cursor + m_file.size()) {}
+
+bool ScriptReader::next(ScriptLine& line) {
+    if (m_hasUnread) {
+        m_hasUnread = false;
+        line = m_unread;
+        return true;
+    }
+    while (m_cursor < m_end) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(m_cursor, '\n', m_end - m_cursor));
+        if (lineEnd == nullptr) {
+            lineEnd = m_end;
+        }
+        ++m_lineNumber;
+        line.number = m_lineNumber;
+        const char* begin = m_cursor;
+        m_cursor = lineEnd == m_end ? m_end : lineEnd + 1;
+        if (!split_line(begin, lineEnd, line)) {
+            throw line_error(line, "too many tokens");
+        }
+        if (line.count > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ScriptReader::unread(const ScriptLine& line) {
+    m_unread = line;
+    m_hasUnread = true;
+}
+
+ScriptAgent::ScriptAgent(ScriptReader& reader) : m_reader(reader) {}
+
+Position ScriptAgent::chooseFlip(const Game& game, const Player&, bool blockActive) {
+    Position target{Letter::A, Number::One};
+    nextMove("flip", false, target);
+    if (!((game.board().flippableMask(blockActive) >> Board::indexOf(target)) & 1u)) {
+        throw line_error(m_line, "card cannot be flipped");
+    }
+    return target;
+}
+
+Position ScriptAgent::chooseOctopusTarget(const Game&, const Player&, const Position&,
+                                          const std::vector<Position>& options) {
+    Position target{Letter::A, Number::One};
+    nextMove("octopus", false, target);
+    if (!listed(options, target)) {
+        throw line_error(m_line, "not an octopus target");
+    }
+    return target;
+}
+
+bool ScriptAgent::choosePenguinTarget(const Game&, const Player&, const std::vector<Position>& options,
+                                      Position& target) {
+    if (!nextMove("penguin", true, target)) {
+        return false;
+    }
+    if (!listed(options, target)) {
+        throw line_error(m_line, "not a penguin target");
+    }
+    return true;
+}
+
+bool ScriptAgent::chooseWalrusBlock(const Game& game, const Player&, Position& target) {
+    if (!nextMove("block", true, target)) {
+        return false;
+    }
+    if (!((game.board().flippableMask(false) >> Board::indexOf(target)) & 1u)) {
+        throw line_error(m_line, "card cannot be blocked");
+    }
+    return true;
+}
+
+bool ScriptAgent::nextMove(const char* command, bool optional, Position& target) {
+    if (!m_reader.next(m_line)) {
+        throw ScriptError(std::string("script ended while expecting ") + command);
+    }
+    if (!m_line.tokens[0].is(command) || m_line.count != 2) {
+        throw line_error(m_line, "unexpected move for this decision");
+    }
+    ++m_moves;
+    if (optional && m_line.tokens[1].is("skip")) {
+        return false;
+    }
+    if (!parse_position(m_line.tokens[1].begin, m_line.tokens[1].end, target)) {
+        throw line_error(m_line, "bad position");
+    }
+    return true;
+}
+
+ScriptReport run_script(const std::string& path, std::ostream& out, ReplayWriter* replay,
+                        const std::vector<GameObserver*>& observers) {
+    ScriptReader reader(path);
+    ScriptAgent agent(reader);
+    CardDeck cardDeck;
+    RubisDeck rubisDeck;
+    Rules rules;
+    ScriptReport report;
+    ScriptLine line;
+    std::string result;
+    while (reader.next(line)) {
+        if (!line.tokens[0].is("game")) {
+            throw line_error(line, "expected a game line");
+        }
+        GameSetup setup;
+        parse_game(line, setup);
+
+        Xoshiro256 rng(setup.seed);
+        cardDeck.setGenerator(rng.split());
+        cardDeck.reset();
+        cardDeck.shuffle();
+        rubisDeck.setGenerator(rng.split());
+        rubisDeck.reset();
+        rubisDeck.shuffle();
+        Game game(cardDeck, setup.options);
+
+        // A side named twice is only an error once the table turns out to be a classic one.
+        std::array<bool, kClassicSeats> taken{};
+        bool clash = false;
+        ScriptLine clashLine;
+        bool more = reader.next(line);
+        for (; more && line.tokens[0].is("player"); more = reader.next(line)) {
+            Side side = Side::Top;
+            if (line.count != 3 || !parse_side(line.tokens[2], side)) {
+                throw line_error(line, "expected: player <name> <top|bottom|left|right>");
+            }
+            if (game.players().size() == kMaxSeats) {
+                throw line_error(line, "too many seats");
+            }
+            if (taken[static_cast<std::size_t>(side)] && !clash) {
+                clash = true;
+                clashLine = line;
+            }
+            taken[static_cast<std::size_t>(side)] = true;
+            game.addPlayer(Player(std::string(line.tokens[1].begin, line.tokens[1].end), side));
+        }
+        if (more) {
+            reader.unread(line);
+        }
+        // bots is checked before it is added, so a huge value cannot wrap the seat count around.
+        const std::size_t scripted = game.players().size();
+        if (setup.bots > kMaxSeats - scripted || scripted + setup.bots < 2) {
+            throw ScriptError("game " + std::to_string(report.games + 1) + ": needs 2-" + std::to_string(kMaxSeats) +
+                              " seats");
+        }
+        const std::size_t seats = scripted + setup.bots;
+        if (replay != nullptr && seats > GameSnapshot::kMaxPlayers) {
+            throw ScriptError("game " + std::to_string(report.games + 1) + ": recorded games have at most " +
+                              std::to_string(GameSnapshot::kMaxPlayers) + " seats");
+        }
+        if (seats <= kClassicSeats) {
+            if (clash) {
+                throw line_error(clashLine, "side already taken");
+            }
+            for (Side side : kClassicSeatOrder) {
+                if (game.players().size() < seats && !taken[static_cast<std::size_t>(side)]) {
+                    game.addPlayer(Player("Bot " + std::to_string(game.players().size() - scripted + 1), side));
+                }
+            }
+        } else {
+            for (std::size_t seat = scripted; seat < seats; ++seat) {
+                game.addPlayer(Player("Bot " + std::to_string(seat - scripted + 1), seat_side(seat, seats)));
+            }
+            for (std::size_t seat = 0; seat < scripted; ++seat) {
+                game.players()[seat].setSide(seat_side(seat, seats));
+            }
+        }
+
+        Engine engine(game, rules, rubisDeck);
+        const std::uint64_t agentSeed = rng();
+        std::vector<std::unique_ptr<MemoryAgent>> bots;
+        for (std::size_t seat = 0; seat < game.players().size(); ++seat) {
+            if (seat < scripted) {
+                engine.setAgent(seat, agent);
+                continue;
+            }
+            bots.emplace_back(new MemoryAgent(agentSeed + seat));
+            engine.setAgent(seat, *bots.back());
+            engine.addObserver(*bots.back());
+        }
+        for (GameObserver* observer : observers) {
+            engine.addObserver(*observer);
+        }
+        std::unique_ptr<ReplayRecorder> recorder;
+        if (replay != nullptr) {
+            recorder.reset(new ReplayRecorder(*replay, engine, setup.seed));
+            engine.addObserver(*recorder);
+        }
+        engine.playGame();
+
+        ++report.games;
+        result.clear();
+        result += "game " + std::to_string(report.games) + " seed=" + std::to_string(setup.seed) + " rubies=";
+        for (std::size_t seat = 0; seat < game.players().size(); ++seat) {
+            if (seat > 0) {
+                result += ',';
+            }
+            result += std::to_string(game.players()[seat].getNRubies());
+        }
+        result += '\n';
+        out.write(result.data(), static_cast<std::streamsize>(result.size()));
+    }
+    report.moves = agent.moves();
+    return report;
+}
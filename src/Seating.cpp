@@ -0,0 +1,126 @@
+// Seating implementation: seat sides and peek windows for classic and large tables on every geometry.
+#include "Seating.h"
+
+#include "CellMasks.h"
+#include "Game.h"
+
+namespace {
+// Edge cells of a Geometry board in clockwise order from A1.
+template <class Geometry>
+struct EdgeRing {
+    static constexpr std::size_t kLength = 2 * (Geometry::kRows + Geometry::kColumns) - 4;
+    // Ring position of the centre of the top front (A3 on the classic board); seat windows start from there.
+    static constexpr std::size_t kStart = Geometry::kColumns / 2;
+
+    std::size_t cells[kLength];
+};
+
+// Description: Walks the border of the grid clockwise from the top-left corner.
+// Returns: EdgeRing<Geometry> with every edge cell once.
+template <class Geometry>
+constexpr EdgeRing<Geometry> make_edge_ring() {
+    constexpr std::size_t rows = Geometry::kRows;
+    constexpr std::size_t columns = Geometry::kColumns;
+    EdgeRing<Geometry> ring{};
+    std::size_t next = 0;
+    for (std::size_t column = 0; column < columns; ++column) {
+        ring.cells[next++] = column;
+    }
+    for (std::size_t row = 1; row < rows; ++row) {
+        ring.cells[next++] = row * columns + columns - 1;
+    }
+    for (std::size_t column = columns - 1; column-- > 0;) {
+        ring.cells[next++] = (rows - 1) * columns + column;
+    }
+    for (std::size_t row = rows - 1; row-- > 1;) {
+        ring.cells[next++] = row * columns;
+    }
+    return ring;
+}
+
+// One shared ring per geometry.
+template <class Geometry>
+struct EdgeRingTable {
+    static constexpr EdgeRing<Geometry> kRing = make_edge_ring<Geometry>();
+};
+
+template <class Geometry>
+constexpr EdgeRing<Geometry> EdgeRingTable<Geometry>::kRing;
+
+// Description: Places a seat on the ring so that the seats of a table are evenly spaced.
+// Parameters: seat (std::size_t), seats (std::size_t).
+// Returns: std::size_t ring position of the centre of the seat's window.
+template <class Geometry>
+constexpr std::size_t ring_centre(std::size_t seat, std::size_t seats) {
+    using Ring = EdgeRing<Geometry>;
+    return (Ring::kStart + seat * Ring::kLength / seats) % Ring::kLength;
+}
+
+// Description: Builds the peek window of a seat: as wide as the table leaves room for, at most three.
+// Parameters: seat (std::size_t), seats (std::size_t).
+// Returns: cell mask of the geometry.
+template <class Geometry>
+constexpr typename Geometry::Mask ring_window(std::size_t seat, std::size_t seats) {
+    using Ring = EdgeRing<Geometry>;
+    using Ops = MaskOps<typename Geometry::Mask>;
+    const std::size_t spacing = Ring::kLength / seats;
+    const std::size_t width = spacing >= 3 ? 3 : (spacing == 0 ? 1 : spacing);
+    const std::size_t first = ring_centre<Geometry>(seat, seats) + Ring::kLength - (width - 1) / 2;
+    auto mask = typename Geometry::Mask{};
+    for (std::size_t offset = 0; offset < width; ++offset) {
+        mask = mask | Ops::bit(EdgeRingTable<Geometry>::kRing.cells[(first + offset) % Ring::kLength]);
+    }
+    return mask;
+}
+
+// Description: Looks up the front a seat on one side peeks at on a classic table.
+// Parameters: side (Side).
+// Returns: cell mask of the geometry.
+template <class Geometry>
+constexpr typename Geometry::Mask side_front(Side side) {
+    return GridTables<Geometry>::kMasks.fronts[static_cast<std::size_t>(side)];
+}
+
+static_assert(ring_window<ClassicGeometry>(0, 4) == front_mask(Side::Top) &&
+                  ring_window<ClassicGeometry>(1, 4) == front_mask(Side::Right) &&
+                  ring_window<ClassicGeometry>(2, 4) == front_mask(Side::Bottom) &&
+                  ring_window<ClassicGeometry>(3, 4) == front_mask(Side::Left),
+              "Four seats on the ring peek at the classic fronts");
+static_assert(ring_window<ClassicGeometry>(4, 5) == 0x8420u, "The fifth of five seats peeks at D1, C1 and B1");
+static_assert(ring_window<Geometry7x7>(0, 5) == 0x1Cu, "The first of five seats on 7x7 peeks at A3, A4 and A5");
+}
+
+template <class Geometry>
+Side seat_side(std::size_t seat, std::size_t seats) {
+    if (seats <= kClassicSeats) {
+        return kClassicSeatOrder[seat];
+    }
+    return kClassicSeatOrder[ring_centre<Geometry>(seat, seats) * kClassicSeats / EdgeRing<Geometry>::kLength];
+}
+
+template <class Geometry>
+typename Geometry::Mask seat_peek_mask(std::size_t seat, std::size_t seats) {
+    if (seats <= kClassicSeats) {
+        return side_front<Geometry>(kClassicSeatOrder[seat]);
+    }
+    return ring_window<Geometry>(seat, seats);
+}
+
+template <class Geometry>
+typename Geometry::Mask peek_mask(const BasicGame<Geometry>& game, std::size_t seat) {
+    const auto& players = game.players();
+    if (players.size() <= kClassicSeats) {
+        return side_front<Geometry>(players[seat].getSide());
+    }
+    return ring_window<Geometry>(seat, players.size());
+}
+
+template Side seat_side<ClassicGeometry>(std::size_t, std::size_t);
+template Side seat_side<Geometry7x7>(std::size_t, std::size_t);
+template Side seat_side<Geometry9x9>(std::size_t, std::size_t);
+template ClassicGeometry::Mask seat_peek_mask<ClassicGeometry>(std::size_t, std::size_t);
+template Geometry7x7::Mask seat_peek_mask<Geometry7x7>(std::size_t, std::size_t);
+template Geometry9x9::Mask seat_peek_mask<Geometry9x9>(std::size_t, std::size_t);
+template ClassicGeometry::Mask peek_mask(const BasicGame<ClassicGeometry>&, std::size_t);
+template Geometry7x7::Mask peek_mask(const BasicGame<Geometry7x7>&, std::size_t);
+template Geometry9x9::Mask peek_mask(const BasicGame<Geometry9x9>&, std::size_t);
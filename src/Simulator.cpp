@@ -0,0 +1,205 @@
+// Simulator implementation: batch of headless games spread over a work-stealing pool.
+#include "Simulator.h"
+
+#include "BasicEngine.h"
+#include "CardDeck.h"
+#include "MemoryAgent.h"
+#include "RandomAgent.h"
+#include "Random.h"
+#include "Replay.h"
+#include "RubisDeck.h"
+#include "Rules.h"
+#include "Snapshot.h"
+#include "ThreadPool.h"
+#include "Trace.h"
+
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace {
+// Per-worker objects reused across games so that workers never share deck state.
+struct WorkerState {
+    std::tuple<GridDeck<ClassicGeometry>, GridDeck<Geometry7x7>, GridDeck<Geometry9x9>> cardDecks;
+    RubisDeck rubisDeck;
+};
+
+// Counts flips of one game without producing any output.
+template <class Geometry>
+class FlipCounter : public BasicGameObserver<Geometry> {
+public:
+    void onEvent(const BasicGame<Geometry>&, const GameEvent& event) override {
+        if (event.type == EventType::Flip) {
+            ++flips;
+        }
+    }
+
+    std::size_t flips{0};
+};
+
+// Description: Builds the bot of one seat on a grid board, as config.gridAgents names it.
+// Parameters: config (const SimulationConfig&), seat (std::size_t), seed (std::uint32_t).
+// Returns: the agent (memory bots are also observers).
+template <class Geometry>
+std::unique_ptr<BasicAgent<Geometry>> make_agent(const SimulationConfig& config, std::size_t seat,
+                                                 std::uint32_t seed) {
+    if (seat < config.gridAgents.size() && config.gridAgents[seat] == 'm') {
+        return std::unique_ptr<BasicAgent<Geometry>>(new BasicMemoryAgent<Geometry>(seed));
+    }
+    return std::unique_ptr<BasicAgent<Geometry>>(new BasicRandomAgent<Geometry>(seed));
+}
+
+// Description: Builds the bot of one seat on the classic board: config.agentFactory's, or a RandomAgent.
+// Parameters: config (const SimulationConfig&), seat (std::size_t), seed (std::uint32_t).
+// Returns: the agent.
+template <>
+std::unique_ptr<Agent> make_agent<ClassicGeometry>(const SimulationConfig& config, std::size_t seat,
+                                                   std::uint32_t seed) {
+    if (config.agentFactory) {
+        return config.agentFactory(seat, seed);
+    }
+    return std::unique_ptr<Agent>(new RandomAgent(seed));
+}
+
+// Statistics and replay observers of one game. Only the classic board records them; the Simulator
+// constructor refuses both on the other boards.
+template <class Geometry>
+struct Recorders {
+    void attach(const SimulationConfig&, GameEngine<Geometry>&, SimulationStats*, std::uint64_t) {}
+};
+
+template <>
+struct Recorders<ClassicGeometry> {
+    // Parameters: config, engine (Engine&), stats (the worker's aggregate, or nullptr), seed (game seed).
+    // Registers the observers the configuration asks for.
+    void attach(const SimulationConfig& config, Engine& engine, SimulationStats* stats, std::uint64_t seed) {
+        if (stats != nullptr) {
+            collector.reset(new StatsCollector(*stats));
+            engine.addObserver(*collector);
+        }
+        if (config.replay != nullptr) {
+            recorder.reset(new ReplayRecorder(*config.replay, engine, seed));
+            engine.addObserver(*recorder);
+        }
+    }
+
+    std::unique_ptr<StatsCollector> collector;
+    std::unique_ptr<ReplayRecorder> recorder;
+};
+
+// Description: Plays one complete game on a Geometry board using the worker's decks, with the turn loop
+// compiled for Policy.
+// Parameters: config (const SimulationConfig&), index (std::size_t), state (WorkerState&),
+// stats (SimulationStats*) the worker's aggregate, or nullptr when not collecting.
+// Returns: GameResult for that game index.
+template <class Policy, class Geometry>
+GameResult play_one(const SimulationConfig& config, std::size_t index, WorkerState& state, SimulationStats* stats) {
+    TRACE_SCOPE("sim.game");
+    GameResult result;
+    result.seed = Simulator::gameSeed(config.seed, index);
+    Xoshiro256 rng(result.seed);
+
+    GridDeck<Geometry>& cardDeck = std::get<GridDeck<Geometry>>(state.cardDecks);
+    cardDeck.setGenerator(rng.split());
+    cardDeck.reset();
+    cardDeck.shuffle();
+    state.rubisDeck.setGenerator(rng.split());
+    state.rubisDeck.reset();
+    state.rubisDeck.shuffle();
+
+    GameOptions options;
+    options.rulesMode = config.rulesMode;
+    BasicGame<Geometry> game(cardDeck, options);
+    std::vector<std::unique_ptr<BasicAgent<Geometry>>> agents;
+    for (std::size_t seat = 0; seat < config.playerCount; ++seat) {
+        game.addPlayer(Player("P" + std::to_string(seat + 1), seat_side<Geometry>(seat, config.playerCount)));
+        agents.push_back(make_agent<Geometry>(config, seat, static_cast<std::uint32_t>(rng())));
+    }
+
+    Rules rules;
+    BasicEngine<Policy, Geometry> engine(game, rules, state.rubisDeck);
+    for (std::size_t seat = 0; seat < agents.size(); ++seat) {
+        engine.setAgent(seat, *agents[seat]);
+        // Agents with memory also need to see every flip and swap.
+        if (auto* observer = dynamic_cast<BasicGameObserver<Geometry>*>(agents[seat].get())) {
+            engine.addObserver(*observer);
+        }
+    }
+    FlipCounter<Geometry> counter;
+    engine.addObserver(counter);
+    Recorders<Geometry> recorders;
+    recorders.attach(config, engine, stats, result.seed);
+    engine.playGame();
+
+    for (std::size_t seat = 0; seat < config.playerCount; ++seat) {
+        result.rubies[seat] = game.players()[seat].getNRubies();
+    }
+    result.flips = counter.flips;
+    return result;
+}
+
+// Description: Plays one game on a Geometry board with the turn loop of config.rulesMode.
+// Parameters: as play_one.
+// Returns: GameResult for that game index.
+template <class Geometry>
+GameResult play_board(const SimulationConfig& config, std::size_t index, WorkerState& state,
+                      SimulationStats* stats) {
+    return config.rulesMode == RulesMode::Expert ? play_one<ExpertRules, Geometry>(config, index, state, stats)
+                                                 : play_one<BaseRules, Geometry>(config, index, state, stats);
+}
+}
+
+Simulator::Simulator(SimulationConfig config) : m_config(std::move(config)) {
+    if (m_config.playerCount < 2 || m_config.playerCount > kMaxSeats) {
+        throw std::invalid_argument("Simulations need 2-" + std::to_string(kMaxSeats) + " players");
+    }
+    if (m_config.replay != nullptr && m_config.playerCount > GameSnapshot::kMaxPlayers) {
+        throw std::invalid_argument("Replays hold at most " + std::to_string(GameSnapshot::kMaxPlayers) + " players");
+    }
+    if (m_config.boardSize != 5 && m_config.boardSize != 7 && m_config.boardSize != 9) {
+        throw std::invalid_argument("Boards are 5x5, 7x7 or 9x9");
+    }
+    if (m_config.boardSize != 5) {
+        if (m_config.replay != nullptr || m_config.collectStats || m_config.agentFactory) {
+            throw std::invalid_argument("Grid boards record no replays or statistics and use grid agents");
+        }
+        if (m_config.gridAgents.find_first_not_of("rm") != std::string::npos) {
+            throw std::invalid_argument("Grid agents are r (random) or m (memory)");
+        }
+    }
+}
+
+std::vector<GameResult> Simulator::run() {
+    std::vector<GameResult> results(m_config.games);
+    WorkStealingPool pool(m_config.threads);
+    std::vector<std::unique_ptr<WorkerState>> workers;
+    for (std::size_t i = 0; i < pool.size(); ++i) {
+        workers.emplace_back(new WorkerState());
+    }
+    // One padded slot per worker: workers only ever touch their own cache lines while playing.
+    std::vector<CacheLinePadded<SimulationStats>> stats(m_config.collectStats ? pool.size() : 0);
+    pool.parallelFor(m_config.games, [&](std::size_t index, std::size_t worker) {
+        SimulationStats* slot = stats.empty() ? nullptr : &stats[worker].value;
+        if (m_config.boardSize == 7) {
+            results[index] = play_board<Geometry7x7>(m_config, index, *workers[worker], slot);
+        } else if (m_config.boardSize == 9) {
+            results[index] = play_board<Geometry9x9>(m_config, index, *workers[worker], slot);
+        } else {
+            results[index] = play_board<ClassicGeometry>(m_config, index, *workers[worker], slot);
+        }
+    });
+    // The pool has joined, so the slots are merged without any locking; every field is a sum,
+    // so the totals do not depend on which worker played which game.
+    m_stats = SimulationStats();
+    for (const auto& slot : stats) {
+        m_stats.merge(slot.value);
+    }
+    return results;
+}
+
+std::uint64_t Simulator::gameSeed(std::uint64_t seed, std::uint64_t index) {
+    // SplitMix64 step from a per-index offset: neighbouring indices map to unrelated seeds.
+    std::uint64_t state = seed + index * 0x9E3779B97F4A7C15ULL;
+    return splitmix64(state);
+}
@@ -0,0 +1,48 @@
+// Snapshot implementation: validation and raw binary I/O for GameSnapshot.
+#include "Snapshot.h"
+
+#include <istream>
+#include <ostream>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<GameSnapshot>::value, "GameSnapshot must be trivially copyable");
+static_assert(sizeof(GameSnapshot) <= 96, "GameSnapshot should stay under 96 bytes");
+
+bool is_valid(const GameSnapshot& snapshot) {
+    if (snapshot.version != GameSnapshot::kVersion || snapshot.playerCount > GameSnapshot::kMaxPlayers ||
+        snapshot.rubyCount > GameSnapshot::kMaxRubies || snapshot.previous >= Card::kCount ||
+        snapshot.current >= Card::kCount || snapshot.origin >= Card::kCount ||
+        snapshot.phase >= GameSnapshot::kPhaseCount) {
+        return false;
+    }
+    if ((snapshot.activeMask >> snapshot.playerCount) != 0 || (snapshot.endOfGameMask >> snapshot.playerCount) != 0) {
+        return false;
+    }
+    if (snapshot.playerCount > 0 && snapshot.currentPlayer >= snapshot.playerCount) {
+        return false;
+    }
+    for (CardId id : snapshot.cards) {
+        if (id >= Card::kCount) {
+            return false;
+        }
+    }
+    for (std::size_t index = 0; index < snapshot.rubyCount; ++index) {
+        if (snapshot.rubyDeck[index] < 1 || snapshot.rubyDeck[index] > 4) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void write_snapshot(std::ostream& os, const GameSnapshot& snapshot) {
+    os.write(reinterpret_cast<const char*>(&snapshot), sizeof(snapshot));
+}
+
+bool read_snapshot(std::istream& is, GameSnapshot& snapshot) {
+    GameSnapshot loaded;
+    if (!is.read(reinterpret_cast<char*>(&loaded), sizeof(loaded)) || !is_valid(loaded)) {
+        return false;
+    }
+    snapshot = loaded;
+    return true;
+}
@@ -0,0 +1,269 @@
+// Statistics implementation: streaming histograms, per-game collection and batch reports.
+#include "Statistics.h"
+
+#include "Game.h"
+
+#include <ostream>
+
+namespace {
+constexpr FaceAnimal kAnimals[] = {FaceAnimal::Crab, FaceAnimal::Penguin, FaceAnimal::Octopus, FaceAnimal::Turtle,
+                                   FaceAnimal::Walrus};
+constexpr Side kSides[] = {Side::Top, Side::Bottom, Side::Left, Side::Right};
+constexpr const char* kEliminationNames[] = {"mismatch", "no-cards-left"};
+
+// Description: Adds the elements of one counter array into another.
+// Parameters: into (std::array<std::uint64_t, N>&), from (const std::array<std::uint64_t, N>&).
+template <std::size_t N>
+void add_counts(std::array<std::uint64_t, N>& into, const std::array<std::uint64_t, N>& from) {
+    for (std::size_t i = 0; i < N; ++i) {
+        into[i] += from[i];
+    }
+}
+
+// Description: Ratio helper that treats an empty denominator as zero.
+// Parameters: part/whole (std::uint64_t).
+// Returns: double part / whole.
+double ratio(std::uint64_t part, std::uint64_t whole) {
+    return whole == 0 ? 0.0 : static_cast<double>(part) / static_cast<double>(whole);
+}
+
+// Description: Writes count, mean and the usual quantiles of a histogram on one line.
+// Parameters: os (std::ostream&), name (const char*), histogram (const Histogram&).
+void report_histogram(std::ostream& os, const char* name, const Histogram& histogram) {
+    os << name << " n=" << histogram.count() << " mean=" << histogram.mean() << " min=" << histogram.min()
+       << " p50=" << histogram.quantile(0.5) << " p90=" << histogram.quantile(0.9)
+       << " p99=" << histogram.quantile(0.99) << " max=" << histogram.max() << '\n';
+}
+
+// Description: Writes the summary rows and every non-empty bin of a histogram as CSV.
+// Parameters: os (std::ostream&), name (const char*), histogram (const Histogram&).
+void csv_histogram(std::ostream& os, const char* name, const Histogram& histogram) {
+    os << name << ",count," << histogram.count() << '\n';
+    os << name << ",mean," << histogram.mean() << '\n';
+    os << name << ",p50," << histogram.quantile(0.5) << '\n';
+    os << name << ",p90," << histogram.quantile(0.9) << '\n';
+    os << name << ",p99," << histogram.quantile(0.99) << '\n';
+    os << name << ",max," << histogram.max() << '\n';
+    for (std::size_t bin = 0; bin < Histogram::kBins; ++bin) {
+        if (histogram.bin(bin) != 0) {
+            os << name << ",bin" << bin << ',' << histogram.bin(bin) << '\n';
+        }
+    }
+}
+}
+
+void Histogram::add(std::uint32_t value) {
+    ++m_bins[value < kBins ? value : kBins - 1];
+    ++m_count;
+    m_sum += value;
+    m_min = value < m_min ? value : m_min;
+    m_max = value > m_max ? value : m_max;
+}
+
+void Histogram::merge(const Histogram& other) {
+    add_counts(m_bins, other.m_bins);
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+    m_min = other.m_min < m_min ? other.m_min : m_min;
+    m_max = other.m_max > m_max ? other.m_max : m_max;
+}
+
+double Histogram::mean() const {
+    return ratio(m_sum, m_count);
+}
+
+std::uint32_t Histogram::quantile(double q) const {
+    if (m_count == 0) {
+        return 0;
+    }
+    const double target = q * static_cast<double>(m_count);
+    std::uint64_t seen = 0;
+    for (std::size_t bin = 0; bin + 1 < kBins; ++bin) {
+        seen += m_bins[bin];
+        if (seen > 0 && static_cast<double>(seen) >= target) {
+            return static_cast<std::uint32_t>(bin);
+        }
+    }
+    return m_max;
+}
+
+void SimulationStats::merge(const SimulationStats& other) {
+    games += other.games;
+    rounds += other.rounds;
+    roundsWithoutWinner += other.roundsWithoutWinner;
+    add_counts(gamesBySide, other.gamesBySide);
+    add_counts(winsBySide, other.winsBySide);
+    add_counts(gamesBySeat, other.gamesBySeat);
+    add_counts(winsBySeat, other.winsBySeat);
+    add_counts(eliminations, other.eliminations);
+    skippedTurns += other.skippedTurns;
+    add_counts(abilityFired, other.abilityFired);
+    add_counts(abilityWasted, other.abilityWasted);
+    add_counts(abilityUserWonRound, other.abilityUserWonRound);
+    flipsPerRound.merge(other.flipsPerRound);
+    rubiesPerSeat.merge(other.rubiesPerSeat);
+    winningRubies.merge(other.winningRubies);
+}
+
+StatsCollector::StatsCollector(SimulationStats& stats) : m_stats(stats) {}
+
+void StatsCollector::onEvent(const Game& game, const GameEvent& event) {
+    switch (event.type) {
+    case EventType::RoundStart:
+        m_roundFlips = 0;
+        m_abilityUsers.fill(0);
+        break;
+    case EventType::Flip:
+        ++m_roundFlips;
+        break;
+    case EventType::Mismatch:
+        ++m_stats.eliminations[static_cast<std::size_t>(Elimination::Mismatch)];
+        break;
+    case EventType::NoCardsLeft:
+        ++m_stats.eliminations[static_cast<std::size_t>(Elimination::NoCardsLeft)];
+        break;
+    case EventType::Skipped:
+        ++m_stats.skippedTurns;
+        break;
+    case EventType::OctopusSwap:
+        ability(FaceAnimal::Octopus, event.player, true);
+        break;
+    case EventType::OctopusNoTarget:
+        ability(FaceAnimal::Octopus, event.player, false);
+        break;
+    case EventType::PenguinFlipDown:
+        ability(FaceAnimal::Penguin, event.player, true);
+        break;
+    case EventType::PenguinSkipped:
+    case EventType::PenguinNoPrevious:
+    case EventType::PenguinNoTarget:
+        ability(FaceAnimal::Penguin, event.player, false);
+        break;
+    case EventType::WalrusBlock:
+        ability(FaceAnimal::Walrus, event.player, true);
+        break;
+    case EventType::WalrusSkipped:
+        ability(FaceAnimal::Walrus, event.player, false);
+        break;
+    case EventType::CrabExtraFlip:
+        ability(FaceAnimal::Crab, event.player, true);
+        break;
+    case EventType::TurtleSkip:
+        ability(FaceAnimal::Turtle, event.player, true);
+        break;
+    case EventType::RubyAwarded:
+        for (std::size_t animal = 0; animal < SimulationStats::kAnimals; ++animal) {
+            if ((m_abilityUsers[animal] >> event.player) & 1u) {
+                ++m_stats.abilityUserWonRound[animal];
+            }
+        }
+        break;
+    case EventType::NoWinner:
+        ++m_stats.roundsWithoutWinner;
+        break;
+    case EventType::RoundEnd:
+        ++m_stats.rounds;
+        m_stats.flipsPerRound.add(m_roundFlips);
+        break;
+    case EventType::GameEnd: {
+        ++m_stats.games;
+        const auto& players = game.players();
+        int best = 0;
+        for (const auto& player : players) {
+            best = player.getNRubies() > best ? player.getNRubies() : best;
+        }
+        m_stats.winningRubies.add(static_cast<std::uint32_t>(best));
+        const bool classic = players.size() <= kClassicSeats;
+        for (std::size_t seat = 0; seat < players.size(); ++seat) {
+            const Player& player = players[seat];
+            const bool won = player.getNRubies() == best;
+            ++m_stats.gamesBySeat[seat];
+            m_stats.winsBySeat[seat] += won ? 1 : 0;
+            if (classic) {
+                const auto side = static_cast<std::size_t>(player.getSide());
+                ++m_stats.gamesBySide[side];
+                m_stats.winsBySide[side] += won ? 1 : 0;
+            }
+            m_stats.rubiesPerSeat.add(static_cast<std::uint32_t>(player.getNRubies()));
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void StatsCollector::ability(FaceAnimal animal, std::size_t player, bool fired) {
+    const auto index = static_cast<std::size_t>(animal);
+    if (!fired) {
+        ++m_stats.abilityWasted[index];
+        return;
+    }
+    ++m_stats.abilityFired[index];
+    m_abilityUsers[index] |= 1u << player;
+}
+
+void write_report(std::ostream& os, const SimulationStats& stats) {
+    os << "games " << stats.games << " rounds " << stats.rounds << " rounds_without_winner "
+       << stats.roundsWithoutWinner << " skipped_turns " << stats.skippedTurns << '\n';
+    for (Side side : kSides) {
+        const auto index = static_cast<std::size_t>(side);
+        if (stats.gamesBySide[index] != 0) {
+            os << "side " << side_name(side) << " games " << stats.gamesBySide[index] << " win_rate "
+               << ratio(stats.winsBySide[index], stats.gamesBySide[index]) << '\n';
+        }
+    }
+    for (std::size_t seat = 0; seat < kMaxSeats; ++seat) {
+        if (stats.gamesBySeat[seat] != 0) {
+            os << "seat " << seat + 1 << " games " << stats.gamesBySeat[seat] << " win_rate "
+               << ratio(stats.winsBySeat[seat], stats.gamesBySeat[seat]) << '\n';
+        }
+    }
+    os << "eliminations";
+    for (std::size_t cause = 0; cause < stats.eliminations.size(); ++cause) {
+        os << ' ' << kEliminationNames[cause] << '=' << stats.eliminations[cause];
+    }
+    os << '\n';
+    report_histogram(os, "flips_per_round", stats.flipsPerRound);
+    report_histogram(os, "rubies_per_seat", stats.rubiesPerSeat);
+    report_histogram(os, "winning_rubies", stats.winningRubies);
+    for (FaceAnimal animal : kAnimals) {
+        const auto index = static_cast<std::size_t>(animal);
+        if (stats.abilityFired[index] + stats.abilityWasted[index] == 0) {
+            continue;
+        }
+        os << "ability " << to_string(animal) << " fired " << stats.abilityFired[index] << " wasted "
+           << stats.abilityWasted[index] << " user_won_round " << stats.abilityUserWonRound[index] << '\n';
+    }
+}
+
+void write_csv(std::ostream& os, const SimulationStats& stats) {
+    os << "metric,key,value\n";
+    os << "games,all," << stats.games << '\n';
+    os << "rounds,all," << stats.rounds << '\n';
+    os << "rounds_without_winner,all," << stats.roundsWithoutWinner << '\n';
+    os << "skipped_turns,all," << stats.skippedTurns << '\n';
+    for (Side side : kSides) {
+        const auto index = static_cast<std::size_t>(side);
+        os << "side_games," << side_name(side) << ',' << stats.gamesBySide[index] << '\n';
+        os << "side_wins," << side_name(side) << ',' << stats.winsBySide[index] << '\n';
+    }
+    for (std::size_t seat = 0; seat < kMaxSeats; ++seat) {
+        if (stats.gamesBySeat[seat] != 0) {
+            os << "seat_games," << seat + 1 << ',' << stats.gamesBySeat[seat] << '\n';
+            os << "seat_wins," << seat + 1 << ',' << stats.winsBySeat[seat] << '\n';
+        }
+    }
+    for (std::size_t cause = 0; cause < stats.eliminations.size(); ++cause) {
+        os << "eliminations," << kEliminationNames[cause] << ',' << stats.eliminations[cause] << '\n';
+    }
+    for (FaceAnimal animal : kAnimals) {
+        const auto index = static_cast<std::size_t>(animal);
+        os << "ability_fired," << to_string(animal) << ',' << stats.abilityFired[index] << '\n';
+        os << "ability_wasted," << to_string(animal) << ',' << stats.abilityWasted[index] << '\n';
+        os << "ability_user_won_round," << to_string(animal) << ',' << stats.abilityUserWonRound[index] << '\n';
+    }
+    csv_histogram(os, "flips_per_round", stats.flipsPerRound);
+    csv_histogram(os, "rubies_per_seat", stats.rubiesPerSeat);
+    csv_histogram(os, "winning_rubies", stats.winningRubies);
+}
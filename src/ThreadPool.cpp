@@ -0,0 +1,132 @@
+// WorkStealingPool implementation: per-worker range queues with stealing from the front.
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+WorkStealingPool::WorkStealingPool(std::size_t threads) {
+    if (threads == 0) {
+        threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+    for (std::size_t i = 0; i < threads; ++i) {
+        m_queues.emplace_back(new Queue());
+    }
+    for (std::size_t i = 0; i < threads; ++i) {
+        m_threads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+std::size_t WorkStealingPool::size() const {
+    return m_threads.size();
+}
+
+void WorkStealingPool::parallelFor(std::size_t count, const std::function<void(std::size_t, std::size_t)>& task) {
+    if (count == 0) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_remaining = count;
+        m_error = nullptr;
+    }
+
+    // Several ranges per worker so that stealing can even out uneven game lengths.
+    const std::size_t workers = m_queues.size();
+    const std::size_t grain = std::max<std::size_t>(1, count / (workers * 8));
+    std::size_t target = 0;
+    for (std::size_t begin = 0; begin < count; begin += grain) {
+        Queue& queue = *m_queues[target];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.ranges.push_back(Range{begin, std::min(count, begin + grain)});
+        }
+        target = (target + 1) % workers;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    ++m_generation;
+    m_wake.notify_all();
+    m_done.wait(lock, [this] { return m_remaining == 0; });
+    m_task = nullptr;
+    if (m_error) {
+        std::exception_ptr error = m_error;
+        m_error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void WorkStealingPool::workerLoop(std::size_t worker) {
+    std::size_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this, seen] { return m_stopping || m_generation != seen; });
+            if (m_stopping) {
+                return;
+            }
+            seen = m_generation;
+        }
+        Range range;
+        while (popLocal(worker, range) || steal(worker, range)) {
+            runRange(worker, range);
+        }
+    }
+}
+
+bool WorkStealingPool::popLocal(std::size_t worker, Range& range) {
+    Queue& queue = *m_queues[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.ranges.empty()) {
+        return false;
+    }
+    range = queue.ranges.back();
+    queue.ranges.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(std::size_t worker, Range& range) {
+    const std::size_t workers = m_queues.size();
+    for (std::size_t offset = 1; offset < workers; ++offset) {
+        Queue& victim = *m_queues[(worker + offset) % workers];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.ranges.empty()) {
+            range = victim.ranges.front();
+            victim.ranges.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::runRange(std::size_t worker, const Range& range) {
+    std::exception_ptr error;
+    for (std::size_t index = range.begin; index < range.end; ++index) {
+        try {
+            (*m_task)(index, worker);
+        } catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (error && !m_error) {
+        m_error = error;
+    }
+    m_remaining -= range.end - range.begin;
+    if (m_remaining == 0) {
+        m_done.notify_all();
+    }
+}
@@ -0,0 +1,124 @@
+// Trace implementation: per-thread event rings and Chrome trace-event export.
+#include "Trace.h"
+
+#include <ostream>
+
+#if MEMOARRR_TRACE
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+static_assert((kTraceCapacity & (kTraceCapacity - 1)) == 0, "Trace capacity must be a power of two");
+
+struct TraceEvent {
+    const char* name;
+    std::uint64_t start;
+    std::uint64_t end;
+};
+
+// Ring written by its owning thread only. The release store of m_written publishes each event,
+// so recording needs no lock; readers wait until the writer is idle.
+class TraceBuffer {
+public:
+    explicit TraceBuffer(std::size_t thread) : m_thread(thread) {}
+
+    void push(const TraceEvent& event) {
+        const std::uint64_t written = m_written.load(std::memory_order_relaxed);
+        m_events[written & (kTraceCapacity - 1)] = event;
+        m_written.store(written + 1, std::memory_order_release);
+    }
+
+    std::uint64_t written() const { return m_written.load(std::memory_order_acquire); }
+    const TraceEvent& at(std::uint64_t index) const { return m_events[index & (kTraceCapacity - 1)]; }
+    std::size_t thread() const { return m_thread; }
+    void clear() { m_written.store(0, std::memory_order_release); }
+
+private:
+    std::array<TraceEvent, kTraceCapacity> m_events;
+    std::atomic<std::uint64_t> m_written{0};
+    std::size_t m_thread;
+};
+
+// Every buffer ever created; buffers outlive their threads so pool workers can be exported after joining.
+struct TraceRegistry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<TraceBuffer>> buffers;
+};
+
+// Description: Returns the process-wide registry (constructed on first use).
+// Returns: TraceRegistry&.
+TraceRegistry& registry() {
+    static TraceRegistry instance;
+    return instance;
+}
+
+// Description: Returns the calling thread's buffer, registering one on the thread's first event.
+// Returns: TraceBuffer&.
+TraceBuffer& local_buffer() {
+    thread_local TraceBuffer* buffer = nullptr;
+    if (buffer == nullptr) {
+        TraceRegistry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        shared.buffers.emplace_back(new TraceBuffer(shared.buffers.size()));
+        buffer = shared.buffers.back().get();
+    }
+    return *buffer;
+}
+
+// Process start on the trace clock, so exported timestamps stay small.
+const std::chrono::steady_clock::time_point kEpoch = std::chrono::steady_clock::now();
+}
+
+std::uint64_t trace_now() {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - kEpoch).count());
+}
+
+void trace_record(const char* name, std::uint64_t start, std::uint64_t end) {
+    local_buffer().push(TraceEvent{name, start, end});
+}
+
+void clear_trace() {
+    TraceRegistry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    for (auto& buffer : shared.buffers) {
+        buffer->clear();
+    }
+}
+
+std::size_t write_chrome_trace(std::ostream& os) {
+    TraceRegistry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    std::size_t count = 0;
+    const auto flags = os.flags();
+    const auto precision = os.precision();
+    os << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+    for (const auto& buffer : shared.buffers) {
+        const std::uint64_t written = buffer->written();
+        const std::uint64_t first = written > kTraceCapacity ? written - kTraceCapacity : 0;
+        for (std::uint64_t index = first; index < written; ++index) {
+            const TraceEvent& event = buffer->at(index);
+            os << (count == 0 ? "\n" : ",\n") << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+               << buffer->thread() << ",\"ts\":" << static_cast<double>(event.start) / 1000.0
+               << ",\"dur\":" << static_cast<double>(event.end - event.start) / 1000.0 << '}';
+            ++count;
+        }
+    }
+    os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    os.flags(flags);
+    os.precision(precision);
+    return count;
+}
+#else
+void clear_trace() {}
+
+std::size_t write_chrome_trace(std::ostream& os) {
+    os << "{\"traceEvents\":[]}\n";
+    return 0;
+}
+#endif
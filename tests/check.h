@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+// Minimal check harness for memoarrr_tests. A failed CHECK reports its file and line and the test
+// keeps going, so one run lists every broken expectation; the process exits with 1 if any failed.
+
+// Parameters: passed (bool), expression (const char*), file (const char*), line (int). Records one check.
+void record_check(bool passed, const char* expression, const char* file, int line);
+// No parameters. Returns the number of failed checks so far.
+std::size_t failed_checks();
+
+// Parameters: body (const std::function<void()>&), fragment (const std::string&). Returns true when
+// body throws a std::exception whose what() contains fragment.
+bool throws_with(const std::function<void()>& body, const std::string& fragment);
+
+#define CHECK(expression) record_check(static_cast<bool>(expression), #expression, __FILE__, __LINE__)
+
+// Test groups, one per source file; memoarrr_tests <group> runs one of them.
+void snapshot_tests();
+void replay_tests();
+void input_tests();
+void seating_tests();
+void grid_tests();
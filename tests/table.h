@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CardDeck.h"
+#include "Engine.h"
+#include "Game.h"
+#include "RandomAgent.h"
+#include "Random.h"
+#include "RubisDeck.h"
+#include "Rules.h"
+#include "Seating.h"
+
+#include <memory>
+#include <string>
+
+// A seeded table whose seats have no agents, so tests drive every decision through the
+// resumable Engine interface.
+struct TestTable {
+    CardDeck cardDeck;
+    RubisDeck rubisDeck;
+    Rules rules;
+    std::unique_ptr<Game> game;
+    std::unique_ptr<Engine> engine;
+
+    // Parameters: seed (std::uint64_t), seats (std::size_t), mode (RulesMode).
+    TestTable(std::uint64_t seed, std::size_t seats, RulesMode mode) {
+        cardDeck.seed(seed);
+        cardDeck.reset();
+        cardDeck.shuffle();
+        rubisDeck.seed(seed + 1);
+        rubisDeck.reset();
+        rubisDeck.shuffle();
+        GameOptions options;
+        options.rulesMode = mode;
+        game.reset(new Game(cardDeck, options));
+        for (std::size_t seat = 0; seat < seats; ++seat) {
+            game->addPlayer(Player("P" + std::to_string(seat + 1), seat_side(seat, seats)));
+        }
+        engine.reset(new Engine(*game, rules, rubisDeck));
+    }
+};
+
+// Parameters: table (TestTable&), rng (Xoshiro256&). Answers the pending request with a random legal
+// move and advances. Returns false once the game is over.
+inline bool play_move(TestTable& table, Xoshiro256& rng) {
+    Engine& engine = *table.engine;
+    const InputRequest& request = engine.advance();
+    const Board& board = table.game->board();
+    switch (request.kind) {
+    case InputKind::None:
+        return false;
+    case InputKind::Flip:
+        engine.submitFlip(Board::positionOf(random_cell(board.flippableMask(request.blockActive), rng)));
+        break;
+    case InputKind::OctopusTarget:
+        engine.submitOctopusTarget(Board::positionOf(random_cell(request.optionMask, rng)));
+        break;
+    case InputKind::PenguinTarget:
+        engine.submitPenguinTarget(rng.bounded(2) == 0, Board::positionOf(random_cell(request.optionMask, rng)));
+        break;
+    case InputKind::WalrusBlock: {
+        const std::uint32_t cells = board.flippableMask(false);
+        engine.submitWalrusBlock(cells != 0 && rng.bounded(2) == 0,
+                                 Board::positionOf(cells != 0 ? random_cell(cells, rng) : 0));
+        break;
+    }
+    }
+    return true;
+}
@@ -0,0 +1,218 @@
+// Grid tests: games on the 7x7 and 9x9 geometries through the shared engine and bots, in both rules
+// modes and on large tables, and grid simulations.
+#include "check.h"
+
+#include "BasicEngine.h"
+#include "CardDeck.h"
+#include "MemoryAgent.h"
+#include "RandomAgent.h"
+#include "Simulator.h"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace {
+// Agent that always asks for the first cell, face down or not.
+template <class Geometry>
+class FirstCellAgent : public BasicAgent<Geometry> {
+public:
+    Position chooseFlip(const BasicGame<Geometry>&, const Player&, bool) override {
+        return BasicBoard<Geometry>::positionOf(0);
+    }
+    Position chooseOctopusTarget(const BasicGame<Geometry>&, const Player&, const Position&,
+                                 const std::vector<Position>& options) override {
+        return options.front();
+    }
+    bool choosePenguinTarget(const BasicGame<Geometry>&, const Player&, const std::vector<Position>&,
+                             Position&) override {
+        return false;
+    }
+    bool chooseWalrusBlock(const BasicGame<Geometry>&, const Player&, Position&) override { return false; }
+};
+
+// Counts the events of one game and records which seat made the first flip of every round.
+template <class Geometry>
+class EventTally : public BasicGameObserver<Geometry> {
+public:
+    void onEvent(const BasicGame<Geometry>&, const GameEvent& event) override {
+        ++counts[static_cast<std::size_t>(event.type)];
+        if (event.type == EventType::RoundStart) {
+            m_roundOpen = true;
+        } else if (event.type == EventType::Flip && m_roundOpen) {
+            openers.push_back(event.player);
+            m_roundOpen = false;
+        }
+    }
+
+    // Parameters: type (EventType). Returns how many events of that type were published.
+    std::size_t count(EventType type) const { return counts[static_cast<std::size_t>(type)]; }
+
+    std::array<std::size_t, static_cast<std::size_t>(EventType::GameEnd) + 1> counts{};
+    std::vector<std::size_t> openers;
+
+private:
+    bool m_roundOpen{false};
+};
+
+// Outcome of one grid game.
+struct GridOutcome {
+    std::vector<int> rubies;
+    std::size_t flips;
+    std::size_t abilities;
+    std::vector<std::size_t> openers;
+};
+
+// Description: Plays one grid game, memory bots on even seats and random bots on odd ones.
+// Parameters: seed (std::uint64_t), seats (std::size_t), mode (RulesMode).
+// Returns: GridOutcome of the game.
+template <class Geometry>
+GridOutcome play_grid_game(std::uint64_t seed, std::size_t seats, RulesMode mode) {
+    GridDeck<Geometry> deck;
+    deck.seed(seed);
+    deck.reset();
+    deck.shuffle();
+    RubisDeck rubisDeck;
+    rubisDeck.seed(seed + 1);
+    rubisDeck.reset();
+    rubisDeck.shuffle();
+    GameOptions options;
+    options.rulesMode = mode;
+    BasicGame<Geometry> game(deck, options);
+    Rules rules;
+    GameEngine<Geometry> engine(game, rules, rubisDeck);
+    std::vector<std::unique_ptr<BasicAgent<Geometry>>> agents;
+    for (std::size_t seat = 0; seat < seats; ++seat) {
+        game.addPlayer(Player("P" + std::to_string(seat + 1), seat_side<Geometry>(seat, seats)));
+        if (seat % 2 == 0) {
+            auto* agent = new BasicMemoryAgent<Geometry>(seed + seat);
+            agents.emplace_back(agent);
+            engine.addObserver(*agent);
+        } else {
+            agents.emplace_back(new BasicRandomAgent<Geometry>(static_cast<std::uint32_t>(seed + seat)));
+        }
+        engine.setAgent(seat, *agents.back());
+    }
+    EventTally<Geometry> tally;
+    engine.addObserver(tally);
+    engine.playGame();
+
+    GridOutcome outcome{{}, tally.count(EventType::Flip), 0, tally.openers};
+    for (EventType ability : {EventType::OctopusSwap, EventType::OctopusNoTarget, EventType::PenguinFlipDown,
+                              EventType::PenguinSkipped, EventType::PenguinNoPrevious, EventType::PenguinNoTarget,
+                              EventType::WalrusBlock, EventType::WalrusSkipped, EventType::CrabExtraFlip,
+                              EventType::TurtleSkip}) {
+        outcome.abilities += tally.count(ability);
+    }
+    int total = 0;
+    for (const Player& player : game.players()) {
+        outcome.rubies.push_back(player.getNRubies());
+        total += player.getNRubies();
+    }
+    // At most one ruby card (1-4 rubies) per round.
+    CHECK(total <= 4 * Rules::kRounds);
+    CHECK(outcome.flips >= Rules::kRounds);
+    CHECK(outcome.openers.size() == static_cast<std::size_t>(Rules::kRounds));
+    return outcome;
+}
+
+// Description: Checks that grid games in both modes and on classic and large tables run to the end,
+// repeat for equal seeds, apply abilities only under expert rules and carry the turn order over on
+// large tables; then that bad agents are refused.
+template <class Geometry>
+void engine_tests() {
+    for (std::size_t seats : {std::size_t{4}, std::size_t{8}, kMaxSeats}) {
+        int rubies = 0;
+        std::size_t baseAbilities = 0;
+        std::size_t expertAbilities = 0;
+        bool carriedOver = false;
+        for (std::uint64_t seed = 1; seed <= 10; ++seed) {
+            const GridOutcome base = play_grid_game<Geometry>(seed, seats, RulesMode::Base);
+            const GridOutcome first = play_grid_game<Geometry>(seed, seats, RulesMode::Expert);
+            const GridOutcome second = play_grid_game<Geometry>(seed, seats, RulesMode::Expert);
+            CHECK(first.flips == second.flips && first.rubies == second.rubies && first.openers == second.openers);
+            baseAbilities += base.abilities;
+            expertAbilities += first.abilities;
+            for (std::size_t round = 0; round < first.openers.size(); ++round) {
+                // Classic tables open every round with seat 0.
+                CHECK(seats > kClassicSeats || first.openers[round] == 0);
+                carriedOver = carriedOver || first.openers[round] != 0;
+            }
+            for (int seatRubies : first.rubies) {
+                rubies += seatRubies;
+            }
+        }
+        CHECK(rubies > 0);
+        CHECK(baseAbilities == 0);
+        CHECK(expertAbilities > 0);
+        CHECK(carriedOver == (seats > kClassicSeats));
+    }
+
+    GridDeck<Geometry> deck;
+    RubisDeck rubisDeck;
+    Rules rules;
+    BasicGame<Geometry> game(deck, GameOptions());
+    game.addPlayer(Player("P1", Side::Top));
+    game.addPlayer(Player("P2", Side::Right));
+    BasicEngine<BaseRules, Geometry> engine(game, rules, rubisDeck);
+    FirstCellAgent<Geometry> first;
+    engine.setAgent(0, first);
+    CHECK(throws_with([&] { engine.playGame(); }, "No agent"));
+    engine.setAgent(1, first);
+    // Cell 0 is turned face up by the first flip, so the second one is refused.
+    CHECK(throws_with([&] { engine.playGame(); }, "cannot be flipped"));
+}
+
+// Description: Checks that GridKnowledge follows swaps across the words of a wide mask.
+void knowledge_tests() {
+    GridKnowledge<Geometry9x9> knowledge;
+    knowledge.learn(3, 17);
+    knowledge.learn(70, 42);
+    knowledge.swap(3, 66);
+    using Ops = MaskOps<Geometry9x9::Mask>;
+    CHECK(!Ops::test(knowledge.known, 3));
+    CHECK(Ops::test(knowledge.known, 66) && knowledge.cards[66] == 17);
+    knowledge.swap(66, 70);
+    CHECK(Ops::test(knowledge.known, 66) && knowledge.cards[66] == 42);
+    CHECK(Ops::test(knowledge.known, 70) && knowledge.cards[70] == 17);
+    CHECK(Ops::count(knowledge.known) == 2);
+}
+
+// Description: Runs an expert 7x7 simulation of eight seats on one and on four threads and checks the
+// setup rules.
+void simulator_tests() {
+    SimulationConfig config;
+    config.games = 200;
+    config.seed = 5;
+    config.playerCount = 8;
+    config.rulesMode = RulesMode::Expert;
+    config.boardSize = 7;
+    config.gridAgents = "mr";
+    config.threads = 1;
+    const std::vector<GameResult> single = Simulator(config).run();
+    config.threads = 4;
+    const std::vector<GameResult> pooled = Simulator(config).run();
+    CHECK(single.size() == 200 && pooled.size() == 200);
+    bool same = true;
+    for (std::size_t index = 0; index < single.size() && index < pooled.size(); ++index) {
+        same = same && single[index].flips == pooled[index].flips && single[index].rubies == pooled[index].rubies;
+    }
+    CHECK(same);
+
+    config.collectStats = true;
+    CHECK(throws_with([&] { Simulator simulator(config); }, "no replays or statistics"));
+    config.collectStats = false;
+    config.gridAgents = "s";
+    CHECK(throws_with([&] { Simulator simulator(config); }, "Grid agents"));
+    config.gridAgents.clear();
+    config.boardSize = 6;
+    CHECK(throws_with([&] { Simulator simulator(config); }, "5x5, 7x7 or 9x9"));
+}
+}
+
+void grid_tests() {
+    engine_tests<Geometry7x7>();
+    engine_tests<Geometry9x9>();
+    knowledge_tests();
+    simulator_tests();
+}
@@ -0,0 +1,97 @@
+// Input tests: malformed or illegal match scripts and protocol commands are rejected with a
+// message, and well-formed ones are accepted.
+#include "check.h"
+
+#include "ProtocolSession.h"
+#include "Script.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace {
+constexpr const char* kScriptPath = "memoarrr_tests_input.script";
+
+// Description: Runs a script given as text.
+// Parameters: text (const std::string&).
+// Returns: ScriptReport of the run (exceptions propagate).
+ScriptReport run_text(const std::string& text) {
+    {
+        std::ofstream out(kScriptPath, std::ios::trunc);
+        out << text;
+    }
+    std::ostringstream sink;
+    return run_script(kScriptPath, sink);
+}
+
+// Description: Sends one protocol command.
+// Parameters: session (ProtocolSession&), line (const std::string&).
+// Returns: std::string reply lines.
+std::string send(ProtocolSession& session, const std::string& line) {
+    std::string out;
+    session.handle(line, out);
+    return out;
+}
+
+// Parameters: reply (const std::string&). Returns true when the reply is a single error line.
+bool is_error(const std::string& reply) {
+    return reply.compare(0, 6, "error ") == 0 && reply.find('\n') == reply.size() - 1;
+}
+
+void script_tests() {
+    CHECK(throws_with([] { run_text("flip A1\n"); }, "line 1: expected a game line"));
+    CHECK(throws_with([] { run_text("game seed=abc\n"); }, "line 1: bad game option"));
+    CHECK(throws_with([] { run_text("game rules=hard\n"); }, "bad game option"));
+    CHECK(throws_with([] { run_text("game seed=99999999999999999999\n"); }, "bad game option"));
+    CHECK(throws_with([] { run_text("game\nplayer Alice middle\n"); }, "line 2: expected: player"));
+    CHECK(throws_with([] { run_text("game\nplayer Alice top\nplayer Bob top\n"); }, "line 3: side already taken"));
+    CHECK(throws_with([] { run_text("game bots=1\n"); }, "needs 2-32 seats"));
+    CHECK(throws_with([] { run_text("game bots=33\n"); }, "needs 2-32 seats"));
+    // Three scripted seats plus 2^64 - 1 bots must not wrap around to a two-seat table.
+    CHECK(throws_with([] { run_text("game bots=18446744073709551615\nplayer A top\nplayer B left\nplayer C right\n"); },
+                      "needs 2-32 seats"));
+    CHECK(throws_with([] { run_text("game\na b c d e f g h i\n"); }, "line 2: too many tokens"));
+    // The centre cell never holds a card, and a scripted seat must answer the decision it is asked.
+    CHECK(throws_with([] { run_text("game bots=1\nplayer Alice top\nflip C3\n"); }, "line 3: card cannot be flipped"));
+    CHECK(throws_with([] { run_text("game bots=1\nplayer Alice top\nflip Z9\n"); }, "line 3: bad position"));
+    CHECK(throws_with([] { run_text("game bots=1\nplayer Alice top\nblock A1\n"); }, "line 3: unexpected move"));
+    CHECK(throws_with([] { run_text("game bots=1\nplayer Alice top\n"); }, "script ended while expecting flip"));
+
+    // Bot-only tables, including a large one, need no moves.
+    const ScriptReport report = run_text("# comment\ngame seed=3 rules=expert bots=2\n\ngame seed=4 bots=12\n");
+    CHECK(report.games == 2);
+    CHECK(report.moves == 0);
+    std::remove(kScriptPath);
+}
+
+void protocol_tests() {
+    ProtocolSession session;
+    CHECK(is_error(send(session, "flip A1")));
+    CHECK(is_error(send(session, "newgame players=40")));
+    CHECK(is_error(send(session, "newgame players=1")));
+    CHECK(is_error(send(session, "newgame players=2 bots=3")));
+    CHECK(is_error(send(session, "newgame rules=hard")));
+    CHECK(is_error(send(session, "newgame seed=x")));
+    // One past the largest 64-bit seed.
+    CHECK(is_error(send(session, "newgame seed=18446744073709551616")));
+    CHECK(is_error(send(session, "newgame colour=red")));
+    CHECK(is_error(send(session, "dance")));
+
+    const std::string started = send(session, "newgame seed=5 players=2 bots=1 events=off");
+    CHECK(started.compare(0, 11, "ok newgame ") == 0);
+    CHECK(started.find("await flip seat=0") != std::string::npos);
+    CHECK(send(session, "flip C3") == "error illegal move\n");
+    CHECK(is_error(send(session, "flip Z9")));
+    CHECK(is_error(send(session, "flip")));
+    CHECK(send(session, "octopus A1") == "error expected flip\n");
+    CHECK(is_error(send(session, "penguin skip")));
+    // A legal flip is accepted and the game goes on.
+    CHECK(!is_error(send(session, "flip A1")));
+    CHECK(send(session, "quit").empty());
+}
+}
+
+void input_tests() {
+    script_tests();
+    protocol_tests();
+}
@@ -0,0 +1,69 @@
+// Test runner: runs every test group, or the one named on the command line (as CTest does).
+#include "check.h"
+
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <vector>
+
+namespace {
+std::size_t g_failed = 0;
+
+// A named test group.
+struct TestGroup {
+    const char* name;
+    void (*run)();
+};
+
+// Registered groups; each test source adds its entry.
+const std::vector<TestGroup> kGroups = {
+    {"snapshot", snapshot_tests},
+    {"replay", replay_tests},
+    {"input", input_tests},
+    {"seating", seating_tests},
+    {"grid", grid_tests},
+};
+}
+
+void record_check(bool passed, const char* expression, const char* file, int line) {
+    if (!passed) {
+        ++g_failed;
+        std::cerr << file << ':' << line << ": check failed: " << expression << '\n';
+    }
+}
+
+std::size_t failed_checks() {
+    return g_failed;
+}
+
+bool throws_with(const std::function<void()>& body, const std::string& fragment) {
+    try {
+        body();
+    } catch (const std::exception& ex) {
+        return std::string(ex.what()).find(fragment) != std::string::npos;
+    }
+    return false;
+}
+
+// Description: Usage: memoarrr_tests [group].
+// Returns: int exit code (0 when every check passed, 1 otherwise).
+int main(int argc, char** argv) {
+    bool ran = false;
+    for (const TestGroup& group : kGroups) {
+        if (argc > 1 && std::strcmp(argv[1], group.name) != 0) {
+            continue;
+        }
+        ran = true;
+        try {
+            group.run();
+        } catch (const std::exception& ex) {
+            record_check(false, ex.what(), group.name, 0);
+        }
+    }
+    if (argc > 1 && !ran) {
+        std::cerr << "Unknown test group " << argv[1] << '\n';
+        return 1;
+    }
+    std::cout << (failed_checks() == 0 ? "all checks passed\n" : "checks failed\n");
+    return failed_checks() == 0 ? 0 : 1;
+}
@@ -0,0 +1,73 @@
+// Replay tests: recorded simulations re-execute identically, and a tampered log is reported.
+#include "check.h"
+
+#include "MemoryAgent.h"
+#include "RandomAgent.h"
+#include "Replay.h"
+#include "Simulator.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace {
+constexpr const char* kLogPath = "memoarrr_tests_replay.mrpl";
+
+// Description: Records a small batch of simulated games into kLogPath.
+// Parameters: mode (RulesMode), games (std::size_t).
+void record_games(RulesMode mode, std::size_t games) {
+    ReplayWriter writer(kLogPath);
+    SimulationConfig config;
+    config.games = games;
+    config.seed = 99;
+    config.threads = 2;
+    config.rulesMode = mode;
+    config.replay = &writer;
+    config.agentFactory = [](std::size_t seat, std::uint32_t seed) -> std::unique_ptr<Agent> {
+        if (seat % 2 == 0) {
+            return std::unique_ptr<Agent>(new MemoryAgent(seed));
+        }
+        return std::unique_ptr<Agent>(new RandomAgent(seed));
+    };
+    Simulator(config).run();
+    writer.flush();
+}
+}
+
+void replay_tests() {
+    std::remove(kLogPath);
+    record_games(RulesMode::Expert, 12);
+    record_games(RulesMode::Base, 8);
+    ReplayReport report = replay_log(kLogPath, 1);
+    CHECK(report.games == 20);
+    CHECK(report.events > 0);
+    CHECK(report.divergent == 0);
+
+    // Change the round number of the first game's first RoundStart record.
+    std::vector<char> bytes;
+    {
+        std::ifstream in(kLogPath, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    const std::size_t records = sizeof(ReplayFileHeader) + sizeof(ReplayGameHeader);
+    CHECK(bytes.size() > records + 2 * sizeof(ReplayRecord));
+    auto* roundStart = reinterpret_cast<ReplayRecord*>(&bytes[records + sizeof(ReplayRecord)]);
+    CHECK(roundStart->type == static_cast<std::uint8_t>(EventType::RoundStart));
+    roundStart->value = static_cast<std::uint8_t>(roundStart->value + 1);
+    {
+        std::ofstream out(kLogPath, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    report = replay_log(kLogPath, 1);
+    CHECK(report.games == 20);
+    CHECK(report.divergent == 1);
+
+    // Anything else is not a replay log.
+    {
+        std::ofstream out(kLogPath, std::ios::binary | std::ios::trunc);
+        out << "not a replay";
+    }
+    CHECK(throws_with([] { replay_log(kLogPath, 1); }, "Not a replay log"));
+    std::remove(kLogPath);
+}
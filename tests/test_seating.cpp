@@ -0,0 +1,117 @@
+// Seating tests: active-seat bookkeeping at the 32-seat limit, the generated peek regions, and the
+// turn order and snapshot limit of large tables.
+#include "check.h"
+#include "table.h"
+
+#include "CellMasks.h"
+#include "Snapshot.h"
+#include "Statistics.h"
+
+#include <stdexcept>
+
+namespace {
+// Description: Checks nextActivePlayer and activeCount on a full 32-seat table.
+void active_seat_tests() {
+    TestTable table(1, kMaxSeats, RulesMode::Base);
+    Game& game = *table.game;
+    game.activateAllPlayers();
+    CHECK(game.activeCount() == kMaxSeats);
+    CHECK(game.activeMask() == 0xFFFFFFFFu);
+    CHECK(game.nextActivePlayer(0) == 1);
+    CHECK(game.nextActivePlayer(30) == 31);
+    CHECK(game.nextActivePlayer(kMaxSeats - 1) == 0);
+
+    for (std::size_t seat = 0; seat < kMaxSeats; ++seat) {
+        game.setPlayerActive(seat, seat == 5 || seat == 31);
+    }
+    CHECK(game.activeCount() == 2);
+    CHECK(game.nextActivePlayer(31) == 5);
+    CHECK(game.nextActivePlayer(5) == 31);
+    CHECK(game.nextActivePlayer(10) == 31);
+    game.setPlayerActive(31, false);
+    CHECK(game.nextActivePlayer(5) == 5);
+    CHECK(game.nextActivePlayer(31) == 5);
+    game.setPlayerActive(5, false);
+    CHECK(game.activeCount() == 0);
+    CHECK(game.nextActivePlayer(12) == 12);
+
+    CHECK(throws_with([&] { game.addPlayer(Player("One too many", Side::Top)); }, "Too many players"));
+}
+
+// Description: Checks the peek windows of every table size.
+void peek_region_tests() {
+    constexpr std::uint32_t kEdge = 0x1F8C63Fu;
+    for (std::size_t seat = 0; seat < kClassicSeats; ++seat) {
+        CHECK(seat_peek_mask(seat, kClassicSeats) == front_mask(kClassicSeatOrder[seat]));
+    }
+    for (std::size_t seats = 2; seats <= kMaxSeats; ++seats) {
+        std::uint32_t seen = 0;
+        bool disjoint = true;
+        for (std::size_t seat = 0; seat < seats; ++seat) {
+            const std::uint32_t cells = seat_peek_mask(seat, seats);
+            CHECK(cells != 0);
+            CHECK((cells & ~kEdge) == 0);
+            disjoint = disjoint && (cells & seen) == 0;
+            seen |= cells;
+        }
+        // Windows only overlap once there are more seats than edge cells.
+        CHECK(disjoint == (seats <= 16));
+    }
+
+    // Large tables peek through the seating model, not the players' sides.
+    TestTable table(2, 6, RulesMode::Base);
+    for (std::size_t seat = 0; seat < 6; ++seat) {
+        CHECK(peek_mask(*table.game, seat) == seat_peek_mask(seat, 6));
+        CHECK(table.game->players()[seat].getSide() == seat_side(seat, 6));
+    }
+    CHECK(throws_with([&] { table.game->getPlayer(Side::Top); }, "more than four players"));
+}
+
+// Description: Plays full 32-seat games and checks that every seat is asked to flip at least once,
+// i.e. later rounds do not all reopen at seat 0, and that statistics are kept per seat, not per side.
+void turn_rotation_tests() {
+    SimulationStats stats;
+    for (std::uint64_t seed = 1; seed <= 8; ++seed) {
+        TestTable table(seed, kMaxSeats, seed % 2 == 0 ? RulesMode::Expert : RulesMode::Base);
+        StatsCollector collector(stats);
+        table.engine->addObserver(collector);
+        Xoshiro256 rng(seed);
+        std::uint32_t flipped = 0;
+        do {
+            const InputRequest& request = table.engine->advance();
+            if (request.kind == InputKind::Flip) {
+                flipped |= 1u << request.player;
+            }
+        } while (play_move(table, rng));
+        CHECK(flipped == 0xFFFFFFFFu);
+    }
+    for (std::size_t seat = 0; seat < kMaxSeats; ++seat) {
+        CHECK(stats.gamesBySeat[seat] == 8);
+    }
+    for (std::size_t side = 0; side < SimulationStats::kSides; ++side) {
+        CHECK(stats.gamesBySide[side] == 0);
+    }
+}
+
+// Description: Checks that large tables refuse snapshots in the middle of a game, once the turn order
+// has carried over, and that a classic snapshot does not restore onto them.
+void large_snapshot_tests() {
+    TestTable large(3, kMaxSeats, RulesMode::Base);
+    Xoshiro256 rng(3);
+    while (large.game->getRound() < 2 && play_move(large, rng)) {
+    }
+    CHECK(large.game->getRound() == 2);
+    CHECK(throws_with([&] { large.engine->snapshot(); }, "at most 4 seats"));
+
+    TestTable classic(3, kClassicSeats, RulesMode::Base);
+    const GameSnapshot snapshot = classic.engine->snapshot();
+    CHECK(throws_with([&] { large.engine->restore(snapshot); }, "does not match"));
+}
+}
+
+void seating_tests() {
+    active_seat_tests();
+    peek_region_tests();
+    turn_rotation_tests();
+    large_snapshot_tests();
+}
@@ -0,0 +1,104 @@
+// Snapshot tests: an engine restored from a snapshot (written and read back in binary form) replays
+// the rest of the game identically, and malformed data is rejected.
+#include "check.h"
+#include "table.h"
+
+#include "Snapshot.h"
+
+#include <sstream>
+
+namespace {
+// Collects every event as one line of numbers.
+class EventLog : public GameObserver {
+public:
+    void onEvent(const Game&, const GameEvent& event) override {
+        text += std::to_string(static_cast<int>(event.type)) + ' ' + std::to_string(event.player) + ' ' +
+                std::to_string(Board::indexOf(event.position)) + ' ' + std::to_string(Board::indexOf(event.target)) +
+                ' ' + std::to_string(event.value) + '\n';
+    }
+
+    std::string text;
+};
+
+// Description: Snapshots a game part-way, plays it out, restores the snapshot (after a trip through
+// its binary form) and plays the same moves again.
+// Parameters: seed (std::uint64_t), seats (std::size_t), mode (RulesMode).
+void check_restore_replays(std::uint64_t seed, std::size_t seats, RulesMode mode) {
+    TestTable table(seed, seats, mode);
+    EventLog log;
+    table.engine->addObserver(log);
+    Xoshiro256 rng(seed);
+    for (std::uint64_t move = 0; move < 1 + seed % 6 && play_move(table, rng);) {
+        ++move;
+    }
+    std::stringstream stream;
+    write_snapshot(stream, table.engine->snapshot());
+    CHECK(stream.str().size() == sizeof(GameSnapshot));
+    const Xoshiro256 rngAtSnapshot = rng;
+
+    log.text.clear();
+    while (play_move(table, rng)) {
+    }
+    const std::string first = log.text;
+    const int rubies = table.game->players()[0].getNRubies();
+
+    GameSnapshot snapshot;
+    CHECK(read_snapshot(stream, snapshot));
+    table.engine->restore(snapshot);
+    rng = rngAtSnapshot;
+    log.text.clear();
+    while (play_move(table, rng)) {
+    }
+    CHECK(!first.empty());
+    CHECK(log.text == first);
+    CHECK(table.game->players()[0].getNRubies() == rubies);
+}
+}
+
+void snapshot_tests() {
+    for (std::uint64_t seed = 1; seed <= 20; ++seed) {
+        check_restore_replays(seed, 4, RulesMode::Expert);
+        check_restore_replays(seed, 2 + seed % 3, RulesMode::Base);
+    }
+
+    TestTable table(7, 3, RulesMode::Expert);
+    Xoshiro256 rng(7);
+    for (int move = 0; move < 12; ++move) {
+        play_move(table, rng);
+    }
+    const GameSnapshot snapshot = table.engine->snapshot();
+    CHECK(is_valid(snapshot));
+
+    // Truncated or out-of-range data is refused.
+    std::stringstream image;
+    write_snapshot(image, snapshot);
+    std::stringstream truncated(image.str().substr(0, image.str().size() / 2));
+    GameSnapshot read;
+    CHECK(!read_snapshot(truncated, read));
+    GameSnapshot corrupt = snapshot;
+    corrupt.playerCount = GameSnapshot::kMaxPlayers + 1;
+    CHECK(!is_valid(corrupt));
+    CHECK(throws_with([&] { table.engine->restore(corrupt); }, "Snapshot"));
+    corrupt = snapshot;
+    corrupt.cards[0] = Card::kCount;
+    CHECK(!is_valid(corrupt));
+    // Seat bits past the player count and unknown turn phases are refused too.
+    corrupt = snapshot;
+    corrupt.activeMask |= 1u << snapshot.playerCount;
+    CHECK(!is_valid(corrupt));
+    CHECK(throws_with([&] { table.engine->restore(corrupt); }, "does not match"));
+    corrupt = snapshot;
+    corrupt.endOfGameMask |= 0x80u;
+    CHECK(!is_valid(corrupt));
+    corrupt = snapshot;
+    corrupt.phase = GameSnapshot::kPhaseCount;
+    CHECK(!is_valid(corrupt));
+    CHECK(throws_with([&] { table.engine->restore(corrupt); }, "does not match"));
+
+    // A snapshot only fits a table with the same number of seats.
+    TestTable other(7, 2, RulesMode::Expert);
+    CHECK(throws_with([&] { other.engine->restore(snapshot); }, "does not match"));
+    // Tables larger than a snapshot can hold cannot be saved.
+    TestTable large(7, GameSnapshot::kMaxPlayers + 1, RulesMode::Base);
+    CHECK(throws_with([&] { large.engine->snapshot(); }, "at most 4 seats"));
+}
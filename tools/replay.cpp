@@ -0,0 +1,34 @@
+// Replay front end: re-executes every game of a replay log and checks it against the recording.
+#include "Replay.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+// Description: Usage: memoarrr_replay <replay-log> [threads].
+// Returns: int exit code (0 when every game replays identically, 1 on divergence or error).
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: memoarrr_replay <replay-log> [threads]\n";
+        return 1;
+    }
+    try {
+        const std::size_t threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 0;
+        const auto start = std::chrono::steady_clock::now();
+        const ReplayReport report = replay_log(argv[1], threads);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        std::cout << "games " << report.games << " events " << report.events << " seconds " << elapsed.count()
+                  << '\n';
+        if (report.divergent > 0) {
+            std::cout << "divergent " << report.divergent << " first seed " << std::hex << report.firstDivergentSeed
+                      << std::dec << ": " << report.firstDivergence << '\n';
+            return 1;
+        }
+        std::cout << "all games match\n";
+    } catch (const std::exception& ex) {
+        std::cerr << "Fatal error: " << ex.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
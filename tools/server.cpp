@@ -0,0 +1,646 @@
+// Table server: hosts many concurrent games in one process. Clients connect over a Unix domain
+// socket and speak the line protocol (see Protocol.h); a single epoll loop drives every table
+// through the resumable Engine, so idle connections and waiting tables cost no threads.
+#include "CardDeck.h"
+#include "Engine.h"
+#include "MemoryAgent.h"
+#include "Protocol.h"
+#include "Random.h"
+#include "RubisDeck.h"
+#include "Rules.h"
+#include "Script.h"
+#include "Seating.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+// Longest accepted input line; longer lines mean a broken client.
+constexpr std::size_t kMaxLine = 512;
+// Clients that stop reading are dropped once this much output is queued for them.
+constexpr std::size_t kMaxQueued = 1 << 20;
+constexpr int kMaxEvents = 256;
+
+volatile std::sig_atomic_t g_stop = 0;
+
+// Description: Signal handler that asks the event loop to exit.
+// Parameters: signal number (unused).
+void request_stop(int) {
+    g_stop = 1;
+}
+
+class Table;
+
+// One client socket with its partial input line and unsent output.
+struct Connection {
+    int fd{-1};
+    std::string input;
+    std::string output;
+    // EPOLLOUT is registered (only while output is waiting for socket space).
+    bool watchingOutput{false};
+    bool queued{false};
+    bool closing{false};
+    Table* table{nullptr};
+    std::size_t seat{0};
+};
+
+// Connections with new output, flushed once per batch of epoll events.
+class Outbox {
+public:
+    // Parameters: connection (Connection&), text (const std::string&). Queues text for the client.
+    void send(Connection& connection, const std::string& text) {
+        connection.output += text;
+        if (!connection.queued) {
+            connection.queued = true;
+            m_pending.push_back(&connection);
+        }
+    }
+
+    std::vector<Connection*>& pending() {
+        return m_pending;
+    }
+
+private:
+    std::vector<Connection*> m_pending;
+};
+
+// Server-side handling time of one player input: parse, engine work and queuing the replies.
+struct LatencyStats {
+    std::size_t turns{0};
+    std::uint64_t totalNs{0};
+    std::uint64_t maxNs{0};
+
+    void add(std::uint64_t ns) {
+        ++turns;
+        totalNs += ns;
+        maxNs = ns > maxNs ? ns : maxNs;
+    }
+};
+
+// Options given by the first client to join a table.
+struct TableOptions {
+    std::size_t players{2};
+    std::size_t bots{0};
+    RulesMode rulesMode{RulesMode::Base};
+    std::uint64_t seed{0};
+};
+
+// One game in progress: remote seats are connections, the remaining seats are MemoryAgents.
+class Table : public GameObserver {
+public:
+    Table(std::string name, const TableOptions& options, Outbox& outbox)
+        : m_name(std::move(name)), m_options(options), m_outbox(outbox) {
+        Xoshiro256 rng(options.seed);
+        m_cardDeck.setGenerator(rng.split());
+        m_cardDeck.shuffle();
+        m_rubisDeck.setGenerator(rng.split());
+        m_rubisDeck.shuffle();
+        GameOptions gameOptions;
+        gameOptions.rulesMode = options.rulesMode;
+        m_game.reset(new Game(m_cardDeck, gameOptions));
+        m_agentSeed = rng();
+    }
+
+    const std::string& name() const {
+        return m_name;
+    }
+
+    bool started() const {
+        return m_engine != nullptr;
+    }
+
+    bool finished() const {
+        return m_finished;
+    }
+
+    // No parameters. Returns true when a client left before the game was over.
+    bool aborted() const {
+        return m_aborted;
+    }
+
+    const LatencyStats& latency() const {
+        return m_latency;
+    }
+
+    // Description: Seats a client and starts the game once every remote seat is taken.
+    // Parameters: connection (Connection&), playerName (const std::string&).
+    void join(Connection& connection, const std::string& playerName) {
+        const std::size_t seat = m_seats.size();
+        m_seats.push_back(&connection);
+        const Side side = seat_side(seat, m_options.players);
+        m_game->addPlayer(Player(playerName, side));
+        connection.table = this;
+        connection.seat = seat;
+        m_outbox.send(connection, "ok joined table=" + m_name + " seat=" + std::to_string(seat) +
+                                      " side=" + side_name(side) + '\n');
+        if (m_seats.size() + m_options.bots == m_options.players) {
+            start();
+        }
+    }
+
+    // Description: Applies one game command from a seated client.
+    // Parameters: connection (Connection&), tokens (const ScriptLine&) the command split in place.
+    void handle(Connection& connection, const ScriptLine& tokens) {
+        const auto begin = std::chrono::steady_clock::now();
+        if (!started()) {
+            m_outbox.send(connection, "error game has not started\n");
+            return;
+        }
+        const InputRequest& request = m_engine->pending();
+        if (request.kind == InputKind::None || request.player != connection.seat) {
+            m_outbox.send(connection, "error not your turn\n");
+            return;
+        }
+        // Commands and positions are a few characters, so these copies stay in the strings' inline storage.
+        const std::string command = tokens.tokens[0].str();
+        switch (submit_move(*m_engine, command, tokens.count == 2 ? tokens.tokens[1].str() : std::string())) {
+        case MoveStatus::Accepted:
+            break;
+        case MoveStatus::Illegal:
+            m_outbox.send(connection, "error illegal move\n");
+            return;
+        case MoveStatus::NotExpected:
+            m_outbox.send(connection, std::string("error expected ") + input_name(request.kind) + '\n');
+            return;
+        case MoveStatus::BadArgument:
+            m_outbox.send(connection, "error expected: " + command + " <position>\n");
+            return;
+        }
+        resume();
+        m_latency.add(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count()));
+    }
+
+    // Description: Sends the current board rendering (the console frame) to one client.
+    // Parameters: connection (Connection&).
+    void sendBoard(Connection& connection) {
+        m_line.clear();
+        append_frame(m_line, *m_game);
+        m_outbox.send(connection, m_line);
+    }
+
+    // Description: Removes a client; a game in progress is abandoned for everybody.
+    // Parameters: connection (Connection&).
+    void leave(Connection& connection) {
+        m_aborted = !m_finished;
+        m_finished = true;
+        for (Connection* seat : m_seats) {
+            if (seat != nullptr && seat != &connection) {
+                m_outbox.send(*seat, "aborted table=" + m_name + '\n');
+            }
+        }
+        release();
+    }
+
+    void onEvent(const Game& game, const GameEvent& event) override {
+        m_line.clear();
+        append_event(m_line, game, event);
+        broadcast(m_line);
+        if (event.type == EventType::Peek && event.player < m_seats.size()) {
+            m_line.clear();
+            append_peek(m_line, game, event.player);
+            m_outbox.send(*m_seats[event.player], m_line);
+        }
+    }
+
+private:
+    void start() {
+        m_engine.reset(new Engine(*m_game, m_rules, m_rubisDeck));
+        for (std::size_t seat = m_seats.size(); seat < m_options.players; ++seat) {
+            m_game->addPlayer(Player("Bot " + std::to_string(seat - m_seats.size() + 1),
+                                     seat_side(seat, m_options.players)));
+            m_bots.emplace_back(new MemoryAgent(m_agentSeed + seat));
+            m_engine->setAgent(seat, *m_bots.back());
+            m_engine->addObserver(*m_bots.back());
+        }
+        m_engine->addObserver(*this);
+        broadcast("start players=" + std::to_string(m_options.players) +
+                  (m_options.rulesMode == RulesMode::Expert ? " rules=expert\n" : " rules=base\n"));
+        resume();
+    }
+
+    // Runs the engine until a remote seat has to decide or the game ends.
+    void resume() {
+        const InputRequest& request = m_engine->advance();
+        if (request.kind != InputKind::None) {
+            m_line.clear();
+            append_request(m_line, *m_game, request);
+            m_outbox.send(*m_seats[request.player], m_line);
+            return;
+        }
+        m_finished = true;
+        std::string summary = "gameover rubies=";
+        for (std::size_t seat = 0; seat < m_game->players().size(); ++seat) {
+            summary += (seat == 0 ? "" : ",") + std::to_string(m_game->players()[seat].getNRubies());
+        }
+        broadcast(summary + '\n');
+        release();
+    }
+
+    void broadcast(const std::string& text) {
+        for (Connection* seat : m_seats) {
+            if (seat != nullptr) {
+                m_outbox.send(*seat, text);
+            }
+        }
+    }
+
+    // Detaches every client so that they can join another table.
+    void release() {
+        for (Connection*& seat : m_seats) {
+            if (seat != nullptr) {
+                seat->table = nullptr;
+                seat = nullptr;
+            }
+        }
+    }
+
+    std::string m_name;
+    TableOptions m_options;
+    Outbox& m_outbox;
+    CardDeck m_cardDeck;
+    RubisDeck m_rubisDeck;
+    Rules m_rules;
+    std::unique_ptr<Game> m_game;
+    std::unique_ptr<Engine> m_engine;
+    std::vector<Connection*> m_seats;
+    std::vector<std::unique_ptr<MemoryAgent>> m_bots;
+    std::uint64_t m_agentSeed{0};
+    LatencyStats m_latency;
+    std::string m_line;
+    bool m_finished{false};
+    bool m_aborted{false};
+};
+
+// Accepts connections and routes their lines to tables from a single epoll loop.
+class Server {
+public:
+    explicit Server(const std::string& path) : m_path(path) {
+        std::random_device entropy;
+        m_seed = (static_cast<std::uint64_t>(entropy()) << 32) | entropy();
+
+        m_listen = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (m_listen < 0) {
+            throw std::runtime_error(std::string("socket: ") + std::strerror(errno));
+        }
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(address.sun_path)) {
+            throw std::runtime_error("Socket path too long");
+        }
+        std::strcpy(address.sun_path, path.c_str());
+        ::unlink(path.c_str());
+        if (::bind(m_listen, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            ::listen(m_listen, SOMAXCONN) != 0) {
+            throw std::runtime_error("Cannot listen on " + path + ": " + std::strerror(errno));
+        }
+        m_epoll = ::epoll_create1(EPOLL_CLOEXEC);
+        if (m_epoll < 0) {
+            throw std::runtime_error(std::string("epoll_create1: ") + std::strerror(errno));
+        }
+        watch(m_listen, EPOLLIN, EPOLL_CTL_ADD);
+    }
+
+    ~Server() {
+        ::close(m_epoll);
+        ::close(m_listen);
+        for (auto& entry : m_connections) {
+            ::close(entry.first);
+        }
+        ::unlink(m_path.c_str());
+    }
+
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+
+    // Description: Runs the event loop until SIGINT/SIGTERM.
+    void run() {
+        std::array<epoll_event, kMaxEvents> events;
+        while (!g_stop) {
+            const int count = ::epoll_wait(m_epoll, events.data(), kMaxEvents, 1000);
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error(std::string("epoll_wait: ") + std::strerror(errno));
+            }
+            for (int i = 0; i < count; ++i) {
+                const int fd = events[i].data.fd;
+                if (fd == m_listen) {
+                    acceptAll();
+                    continue;
+                }
+                auto found = m_connections.find(fd);
+                if (found == m_connections.end()) {
+                    continue;
+                }
+                Connection& connection = *found->second;
+                if (events[i].events & EPOLLIN) {
+                    readFrom(connection);
+                }
+                if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+                    connection.closing = true;
+                }
+                if (connection.closing || (events[i].events & EPOLLOUT)) {
+                    m_outbox.send(connection, std::string());
+                }
+            }
+            flushAll();
+        }
+        report();
+    }
+
+private:
+    void watch(int fd, std::uint32_t events, int operation) {
+        epoll_event event{};
+        event.events = events;
+        event.data.fd = fd;
+        if (::epoll_ctl(m_epoll, operation, fd, &event) != 0) {
+            throw std::runtime_error(std::string("epoll_ctl: ") + std::strerror(errno));
+        }
+    }
+
+    void acceptAll() {
+        while (true) {
+            const int fd = ::accept4(m_listen, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                    std::cerr << "accept: " << std::strerror(errno) << '\n';
+                }
+                return;
+            }
+            std::unique_ptr<Connection> connection(new Connection());
+            connection->fd = fd;
+            watch(fd, EPOLLIN, EPOLL_CTL_ADD);
+            m_connections[fd] = std::move(connection);
+        }
+    }
+
+    void readFrom(Connection& connection) {
+        char buffer[4096];
+        while (true) {
+            const ssize_t got = ::read(connection.fd, buffer, sizeof(buffer));
+            if (got > 0) {
+                connection.input.append(buffer, static_cast<std::size_t>(got));
+                continue;
+            }
+            if (got == 0) {
+                connection.closing = true;
+            } else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                connection.closing = true;
+            }
+            break;
+        }
+
+        // Lines are split in place; dispatching never touches connection.input.
+        std::size_t start = 0;
+        for (std::size_t end = connection.input.find('\n'); end != std::string::npos;
+             end = connection.input.find('\n', start)) {
+            const char* line = connection.input.data();
+            dispatch(connection, line + start, line + end);
+            start = end + 1;
+            if (connection.closing) {
+                break;
+            }
+        }
+        connection.input.erase(0, start);
+        if (connection.input.size() > kMaxLine) {
+            connection.closing = true;
+        }
+    }
+
+    void dispatch(Connection& connection, const char* begin, const char* end) {
+        ScriptLine tokens;
+        if (!split_line(begin, end, tokens)) {
+            m_outbox.send(connection, "error too many tokens\n");
+            return;
+        }
+        if (tokens.count == 0) {
+            return;
+        }
+        const ScriptToken& command = tokens.tokens[0];
+        if (command.is("join")) {
+            join(connection, tokens);
+        } else if (command.is("board")) {
+            if (connection.table != nullptr && connection.table->started()) {
+                connection.table->sendBoard(connection);
+            } else {
+                m_outbox.send(connection, "error not playing\n");
+            }
+        } else if (command.is("stats")) {
+            m_outbox.send(connection, "stats connections=" + std::to_string(m_connections.size()) +
+                                          " tables=" + std::to_string(m_tables.size()) +
+                                          " games=" + std::to_string(m_gamesFinished) +
+                                          " aborted=" + std::to_string(m_gamesAborted) + '\n');
+        } else if (command.is("quit")) {
+            connection.closing = true;
+        } else if (connection.table != nullptr && is_move_command(command.str())) {
+            Table* table = connection.table;
+            table->handle(connection, tokens);
+            retireIfDone(*table);
+        } else {
+            m_outbox.send(connection, "error unknown command\n");
+        }
+    }
+
+    // join <table> [players=N] [bots=N] [rules=base|expert] [seed=N] [name=X]
+    void join(Connection& connection, const ScriptLine& tokens) {
+        if (connection.table != nullptr) {
+            m_outbox.send(connection, "error already seated\n");
+            return;
+        }
+        if (tokens.count < 2) {
+            m_outbox.send(connection, "error expected: join <table> [players=N] [bots=N] [rules=base|expert]\n");
+            return;
+        }
+        TableOptions options;
+        options.seed = splitmix64(m_seed);
+        std::string playerName = "Player";
+        for (std::size_t i = 2; i < tokens.count; ++i) {
+            const ScriptToken& token = tokens.tokens[i];
+            const char* equals = std::find(token.begin, token.end, '=');
+            const ScriptToken key{token.begin, equals};
+            const ScriptToken value{equals == token.end ? equals : equals + 1, token.end};
+            std::uint64_t number = 0;
+            bool valid = true;
+            if (key.is("players")) {
+                valid = value.toNumber(number) && number <= kMaxSeats;
+                options.players = static_cast<std::size_t>(number);
+            } else if (key.is("bots")) {
+                valid = value.toNumber(number) && number <= kMaxSeats;
+                options.bots = static_cast<std::size_t>(number);
+            } else if (key.is("rules")) {
+                valid = value.is("base") || value.is("expert");
+                options.rulesMode = value.is("expert") ? RulesMode::Expert : RulesMode::Base;
+            } else if (key.is("seed")) {
+                valid = value.toNumber(options.seed);
+            } else if (key.is("name")) {
+                valid = value.begin != value.end;
+                playerName = value.str();
+            } else {
+                valid = false;
+            }
+            if (!valid) {
+                m_outbox.send(connection, "error bad option " + token.str() + '\n');
+                return;
+            }
+        }
+
+        const std::string name = tokens.tokens[1].str();
+        auto found = m_tables.find(name);
+        if (found == m_tables.end()) {
+            if (options.players < 2 || options.players > kMaxSeats || options.bots >= options.players) {
+                m_outbox.send(connection, "error tables need 2-" + std::to_string(kMaxSeats) +
+                                              " players and at least one remote seat\n");
+                return;
+            }
+            found = m_tables.emplace(name, std::unique_ptr<Table>(new Table(name, options, m_outbox))).first;
+        } else if (found->second->started()) {
+            m_outbox.send(connection, "error table is full\n");
+            return;
+        }
+        found->second->join(connection, playerName);
+        retireIfDone(*found->second);
+    }
+
+    // Drops a table once its game is over (or was abandoned). Only games played to the end are
+    // counted and have their turn latency logged.
+    void retireIfDone(Table& table) {
+        if (!table.finished()) {
+            return;
+        }
+        if (table.aborted()) {
+            ++m_gamesAborted;
+        } else {
+            const LatencyStats& latency = table.latency();
+            if (latency.turns > 0) {
+                std::cout << "table " << table.name() << " turns " << latency.turns << " mean_us "
+                          << latency.totalNs / 1000.0 / latency.turns << " max_us " << latency.maxNs / 1000.0 << '\n';
+            }
+            m_total.turns += latency.turns;
+            m_total.totalNs += latency.totalNs;
+            m_total.maxNs = latency.maxNs > m_total.maxNs ? latency.maxNs : m_total.maxNs;
+            ++m_gamesFinished;
+        }
+        // The key is copied first: the name lives in the Table that the erase destroys.
+        const std::string name = table.name();
+        m_tables.erase(name);
+    }
+
+    // Writes queued output and closes connections marked for closing.
+    void flushAll() {
+        std::vector<Connection*>& pending = m_outbox.pending();
+        for (std::size_t i = 0; i < pending.size(); ++i) {
+            Connection& connection = *pending[i];
+            connection.queued = false;
+            if (!connection.closing) {
+                write(connection);
+            }
+            if (connection.closing) {
+                close(connection);
+            }
+        }
+        pending.clear();
+    }
+
+    void write(Connection& connection) {
+        std::size_t sent = 0;
+        while (sent < connection.output.size()) {
+            const ssize_t count = ::send(connection.fd, connection.output.data() + sent,
+                                         connection.output.size() - sent, MSG_NOSIGNAL);
+            if (count < 0) {
+                if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                    connection.closing = true;
+                }
+                break;
+            }
+            sent += static_cast<std::size_t>(count);
+        }
+        connection.output.erase(0, sent);
+        if (connection.output.size() > kMaxQueued) {
+            connection.closing = true;
+            return;
+        }
+        // Only ask for EPOLLOUT while output is stuck, so idle sockets never wake the loop.
+        const bool wantOutput = !connection.output.empty();
+        if (wantOutput != connection.watchingOutput) {
+            watch(connection.fd, wantOutput ? (EPOLLIN | EPOLLOUT) : EPOLLIN, EPOLL_CTL_MOD);
+            connection.watchingOutput = wantOutput;
+        }
+    }
+
+    void close(Connection& connection) {
+        if (connection.table != nullptr) {
+            Table* table = connection.table;
+            table->leave(connection);
+            if (!table->started()) {
+                // Nobody played yet: the other seats stay released and the table is dropped. The key is
+                // copied first because the name lives in the Table that the erase destroys.
+                const std::string name = table->name();
+                m_tables.erase(name);
+            } else {
+                retireIfDone(*table);
+            }
+        }
+        ::close(connection.fd);
+        m_connections.erase(connection.fd);
+    }
+
+    void report() const {
+        std::cout << "games " << m_gamesFinished << " aborted " << m_gamesAborted << " turns " << m_total.turns;
+        if (m_total.turns > 0) {
+            std::cout << " mean_us " << m_total.totalNs / 1000.0 / m_total.turns << " max_us "
+                      << m_total.maxNs / 1000.0;
+        }
+        std::cout << '\n';
+    }
+
+    std::string m_path;
+    std::uint64_t m_seed{0};
+    int m_listen{-1};
+    int m_epoll{-1};
+    Outbox m_outbox;
+    std::unordered_map<int, std::unique_ptr<Connection>> m_connections;
+    std::map<std::string, std::unique_ptr<Table>> m_tables;
+    std::size_t m_gamesFinished{0};
+    std::size_t m_gamesAborted{0};
+    LatencyStats m_total;
+};
+
+} // namespace
+
+// Description: Usage: memoarrr_server [socket-path] (default /tmp/memoarrr.sock).
+// Returns: int exit code (0 after SIGINT/SIGTERM, 1 on fatal error).
+int main(int argc, char** argv) {
+    const std::string path = argc > 1 ? argv[1] : "/tmp/memoarrr.sock";
+    std::signal(SIGINT, request_stop);
+    std::signal(SIGTERM, request_stop);
+    std::signal(SIGPIPE, SIG_IGN);
+    try {
+        Server server(path);
+        std::cout << "listening on " << path << std::endl;
+        server.run();
+    } catch (const std::exception& ex) {
+        std::cerr << "Fatal error: " << ex.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
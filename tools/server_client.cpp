@@ -0,0 +1,196 @@
+// Load client for memoarrr_server: fills tables with scripted players that answer every request
+// with a random legal move, optionally holds extra idle connections, and reports throughput and
+// the latency between sending a move and the server's first reply.
+#include "Random.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// One scripted player connection.
+struct Client {
+    int fd{-1};
+    std::string input;
+    bool done{false};
+    bool waitingReply{false};
+    Clock::time_point sentAt;
+};
+
+// Description: Opens a blocking connection to the server socket.
+// Parameters: path (const std::string&).
+// Returns: int file descriptor; throws std::runtime_error on failure.
+int connect_to(const std::string& path) {
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        throw std::runtime_error("Cannot connect to " + path + ": " + std::strerror(errno));
+    }
+    return fd;
+}
+
+// Description: Writes a whole line to a socket.
+// Parameters: fd (int), line (const std::string&).
+void send_line(int fd, const std::string& line) {
+    std::size_t sent = 0;
+    while (sent < line.size()) {
+        const ssize_t count = ::send(fd, line.data() + sent, line.size() - sent, MSG_NOSIGNAL);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error(std::string("send: ") + std::strerror(errno));
+        }
+        sent += static_cast<std::size_t>(count);
+    }
+}
+
+// Description: Picks the answer to an "await" line.
+// Parameters: line (const std::string&), rng (Xoshiro256&).
+// Returns: std::string command line such as "flip B3\n".
+std::string answer(const std::string& line, Xoshiro256& rng) {
+    std::istringstream in(line);
+    std::string word;
+    std::string kind;
+    in >> word >> kind;
+    std::vector<std::string> options;
+    while (in >> word) {
+        if (word.compare(0, 8, "options=") == 0) {
+            std::istringstream list(word.substr(8));
+            std::string option;
+            while (std::getline(list, option, ',')) {
+                options.push_back(option);
+            }
+        }
+    }
+    const bool optional = kind == "penguin" || kind == "block";
+    if (options.empty() || (optional && rng.bounded(4) == 0)) {
+        return kind + " skip\n";
+    }
+    return kind + ' ' + options[rng.bounded(static_cast<std::uint32_t>(options.size()))] + '\n';
+}
+
+} // namespace
+
+// Description: Usage: memoarrr_client [socket] [tables] [players] [base|expert] [idle].
+// Returns: int exit code (0 when every game finished, 1 otherwise).
+int main(int argc, char** argv) {
+    const std::string path = argc > 1 ? argv[1] : "/tmp/memoarrr.sock";
+    const std::size_t tables = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100;
+    const std::size_t players = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 4;
+    const std::string rules = argc > 4 ? argv[4] : "expert";
+    const std::size_t idle = argc > 5 ? std::strtoul(argv[5], nullptr, 10) : 0;
+
+    try {
+        std::vector<int> idleConnections;
+        for (std::size_t i = 0; i < idle; ++i) {
+            idleConnections.push_back(connect_to(path));
+        }
+
+        const auto start = Clock::now();
+        std::vector<Client> clients(tables * players);
+        for (std::size_t i = 0; i < clients.size(); ++i) {
+            clients[i].fd = connect_to(path);
+            send_line(clients[i].fd, "join load-" + std::to_string(::getpid()) + '-' + std::to_string(i / players) +
+                                         " players=" + std::to_string(players) + " rules=" + rules + " name=c" +
+                                         std::to_string(i) + '\n');
+        }
+
+        Xoshiro256 rng(static_cast<std::uint64_t>(::getpid()));
+        std::vector<pollfd> polls(clients.size());
+        std::size_t remaining = clients.size();
+        std::size_t moves = 0;
+        std::uint64_t totalNs = 0;
+        std::uint64_t maxNs = 0;
+        while (remaining > 0) {
+            for (std::size_t i = 0; i < clients.size(); ++i) {
+                polls[i].fd = clients[i].done ? -1 : clients[i].fd;
+                polls[i].events = POLLIN;
+                polls[i].revents = 0;
+            }
+            if (::poll(polls.data(), polls.size(), 10000) <= 0) {
+                throw std::runtime_error("Server stopped responding");
+            }
+            for (std::size_t i = 0; i < clients.size(); ++i) {
+                if (!(polls[i].revents & (POLLIN | POLLHUP))) {
+                    continue;
+                }
+                Client& client = clients[i];
+                char buffer[4096];
+                const ssize_t got = ::read(client.fd, buffer, sizeof(buffer));
+                if (got <= 0) {
+                    throw std::runtime_error("Server closed a connection");
+                }
+                if (client.waitingReply) {
+                    const auto ns = static_cast<std::uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - client.sentAt).count());
+                    totalNs += ns;
+                    maxNs = std::max(maxNs, ns);
+                    client.waitingReply = false;
+                }
+                client.input.append(buffer, static_cast<std::size_t>(got));
+                std::size_t begin = 0;
+                for (std::size_t end = client.input.find('\n'); end != std::string::npos;
+                     end = client.input.find('\n', begin)) {
+                    const std::string line = client.input.substr(begin, end - begin);
+                    begin = end + 1;
+                    if (line.compare(0, 6, "await ") == 0) {
+                        send_line(client.fd, answer(line, rng));
+                        client.sentAt = Clock::now();
+                        client.waitingReply = true;
+                        ++moves;
+                    } else if (line.compare(0, 8, "gameover") == 0 || line.compare(0, 7, "aborted") == 0) {
+                        client.done = true;
+                        --remaining;
+                    } else if (line.compare(0, 5, "error") == 0) {
+                        throw std::runtime_error("Server error: " + line);
+                    }
+                }
+                client.input.erase(0, begin);
+            }
+        }
+        const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+        send_line(clients.front().fd, "stats\n");
+        std::string stats;
+        char c = 0;
+        while (::read(clients.front().fd, &c, 1) == 1 && c != '\n') {
+            stats += c;
+        }
+        std::cout << "tables " << tables << " moves " << moves << " seconds " << elapsed.count() << " moves_per_sec "
+                  << moves / elapsed.count() << '\n';
+        if (moves > 0) {
+            std::cout << "reply latency mean_us " << totalNs / 1000.0 / moves << " max_us " << maxNs / 1000.0 << '\n';
+        }
+        std::cout << stats << '\n';
+        for (const Client& client : clients) {
+            ::close(client.fd);
+        }
+        for (int fd : idleConnections) {
+            ::close(fd);
+        }
+    } catch (const std::exception& ex) {
+        std::cerr << "Fatal error: " << ex.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,187 @@
+// Batch simulator front end: plays many headless games and prints aggregate results.
+#include "MctsAgent.h"
+#include "MemoryAgent.h"
+#include "RandomAgent.h"
+#include "Replay.h"
+#include "Simulator.h"
+#include "Statistics.h"
+#include "Trace.h"
+
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr const char* kUsage =
+    "usage: memoarrr_sim [games] [seed] [threads] [players] [base|expert] [agents] [replay-log]\n"
+    "                    [--stats] [--csv=<path>] [--trace=<path>] [--board=5|7|9]\n"
+    "agents: one letter per seat, r = random, m = memory, s = tree search (5x5 only)\n";
+
+// Command line that does not match the usage; main prints the usage with it.
+class UsageError : public std::invalid_argument {
+public:
+    explicit UsageError(const std::string& msg) : std::invalid_argument(msg) {}
+};
+
+// Description: Reads an unsigned command-line argument or falls back to a default.
+// Parameters: args (const std::vector<std::string>&) positional arguments, index (std::size_t),
+// fallback (unsigned long long).
+// Returns: unsigned long long parsed value; throws UsageError unless the whole argument is a decimal number.
+unsigned long long argument(const std::vector<std::string>& args, std::size_t index, unsigned long long fallback) {
+    if (index >= args.size()) {
+        return fallback;
+    }
+    const std::string& text = args[index];
+    char* end = nullptr;
+    errno = 0;
+    const unsigned long long value = std::strtoull(text.c_str(), &end, 10);
+    // strtoull accepts a sign and leading spaces, so the first character is checked as well.
+    if (text.empty() || text[0] < '0' || text[0] > '9' || *end != '\0' || errno == ERANGE) {
+        throw UsageError("Expected a non-negative number, got \"" + text + '"');
+    }
+    return value;
+}
+
+} // namespace
+
+// Description: Usage: memoarrr_sim [games] [seed] [threads] [players] [base|expert] [agents] [replay-log]
+// [--stats] [--csv=<path>] [--trace=<path>] [--board=5|7|9].
+// agents is one letter per seat: r = RandomAgent (default), m = MemoryAgent, s = MctsAgent
+// (500 iterations per decision, single-threaded so batch workers stay independent).
+// replay-log, when given, receives every game (appended) for memoarrr_replay.
+// --stats prints the aggregated statistics report; --csv writes the same statistics as CSV.
+// --trace writes Chrome trace-event JSON (only populated when built with MEMOARRR_TRACE=ON).
+// --board=7 or --board=9 plays the same games on the 7x7 or 9x9 stress geometry with random or
+// memory seats (no replay log or statistics).
+// Options may appear anywhere; the remaining arguments are positional.
+// Returns: int exit code (0 for success, 1 on fatal error).
+int main(int argc, char** argv) {
+    try {
+        std::vector<std::string> args;
+        bool report = false;
+        std::string csvPath;
+        std::string tracePath;
+        std::string board = "5";
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg == "--stats") {
+                report = true;
+            } else if (arg.compare(0, 6, "--csv=") == 0) {
+                csvPath = arg.substr(6);
+            } else if (arg.compare(0, 8, "--trace=") == 0) {
+                tracePath = arg.substr(8);
+            } else if (arg.compare(0, 8, "--board=") == 0) {
+                board = arg.substr(8);
+            } else if (arg.compare(0, 2, "--") == 0) {
+                throw UsageError("Unknown option " + arg);
+            } else {
+                args.push_back(arg);
+            }
+        }
+
+        SimulationConfig config;
+        config.games = argument(args, 0, 10000);
+        config.seed = argument(args, 1, 1);
+        config.threads = argument(args, 2, 0);
+        config.playerCount = argument(args, 3, 4);
+        if (args.size() > 4) {
+            if (args[4] != "base" && args[4] != "expert") {
+                throw UsageError("Expected base or expert, got \"" + args[4] + '"');
+            }
+            config.rulesMode = args[4] == "expert" ? RulesMode::Expert : RulesMode::Base;
+        }
+        if (board != "5" && board != "7" && board != "9") {
+            throw UsageError("Expected a board of 5, 7 or 9, got \"" + board + '"');
+        }
+        config.boardSize = static_cast<std::size_t>(board[0] - '0');
+        config.collectStats = report || !csvPath.empty();
+        if (args.size() > 5) {
+            const std::string seats = args[5];
+            if (seats.find_first_not_of(config.boardSize == 5 ? "rms" : "rm") != std::string::npos) {
+                throw UsageError("Unknown agent letter in \"" + seats + '"');
+            }
+            if (config.boardSize != 5) {
+                config.gridAgents = seats;
+            } else {
+                config.agentFactory = [seats](std::size_t seat, std::uint32_t seed) -> std::unique_ptr<Agent> {
+                    if (seat < seats.size() && seats[seat] == 'm') {
+                        return std::unique_ptr<Agent>(new MemoryAgent(seed));
+                    }
+                    if (seat < seats.size() && seats[seat] == 's') {
+                        MctsConfig search;
+                        search.iterations = 500;
+                        return std::unique_ptr<Agent>(new MctsAgent(seed, search));
+                    }
+                    return std::unique_ptr<Agent>(new RandomAgent(seed));
+                };
+            }
+        }
+
+        std::unique_ptr<ReplayWriter> replay;
+        if (args.size() > 6) {
+            replay.reset(new ReplayWriter(args[6]));
+            config.replay = replay.get();
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        Simulator simulator(config);
+        const auto results = simulator.run();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        // FNV-1a over all results: equal checksums mean identical batches.
+        unsigned long long checksum = 1469598103934665603ULL;
+        auto mix = [&checksum](unsigned long long value) {
+            checksum = (checksum ^ value) * 1099511628211ULL;
+        };
+        unsigned long long flips = 0;
+        std::array<long long, kMaxSeats> rubies{};
+        for (const auto& result : results) {
+            mix(result.flips);
+            for (std::size_t seat = 0; seat < config.playerCount; ++seat) {
+                mix(static_cast<unsigned long long>(result.rubies[seat]));
+                rubies[seat] += result.rubies[seat];
+            }
+            flips += result.flips;
+        }
+
+        std::cout << "games " << results.size() << " flips " << flips << " seconds " << elapsed.count() << '\n';
+        for (std::size_t seat = 0; seat < config.playerCount; ++seat) {
+            std::cout << "seat " << (seat + 1) << " rubies " << rubies[seat] << '\n';
+        }
+        std::cout << "checksum " << std::hex << checksum << std::dec << '\n';
+        if (report) {
+            write_report(std::cout, simulator.stats());
+        }
+        if (!csvPath.empty()) {
+            std::ofstream csv(csvPath);
+            if (!csv) {
+                throw std::runtime_error("Cannot open " + csvPath);
+            }
+            write_csv(csv, simulator.stats());
+        }
+        if (!tracePath.empty()) {
+            std::ofstream trace(tracePath);
+            if (!trace) {
+                throw std::runtime_error("Cannot open " + tracePath);
+            }
+            if (write_chrome_trace(trace) == 0 && !kTraceEnabled) {
+                std::cerr << "Tracing is compiled out; configure with -DMEMOARRR_TRACE=ON\n";
+            }
+        }
+    } catch (const UsageError& ex) {
+        std::cerr << ex.what() << '\n' << kUsage;
+        return 1;
+    } catch (const std::exception& ex) {
+        std::cerr << "Fatal error: " << ex.what() << '\n';
+        return 1;
+    }
+    return 0;
+}